@@ -27,7 +27,18 @@
 #include "sleep.h"
 
 #include "pll_q30.h"
+#include "pll_config.h"
+#include "pll_engine.h"
 #include "sine_q230_1024.h"
+#ifdef PLL_USE_MAILBOX
+  #include "pll_mailbox.h"
+#endif
+#ifdef PLL_BENCH_BRAM_OUT
+  #include "pll_bram_out.h"
+#endif
+#ifdef PLL_BENCH_BIQUAD
+  #include "pll_biquad.h"
+#endif
 
 
 
@@ -38,6 +49,11 @@
   #define BRAM_BASE_ADDR   XPAR_AXI_BRAM_CTRL_0_S_AXI_BASEADDR
 #endif
 
+// Output region (pll_bram_out) sits right after the Q22 input table.
+#ifndef BRAM_OUT_BASE_ADDR
+  #define BRAM_OUT_BASE_ADDR  (BRAM_BASE_ADDR + 4u * SINE_N)
+#endif
+
 // ---------------- GPIO probe (AXI GPIO) ----------------
 // AXI GPIO register map (channel 1): 0x00 DATA, 0x04 TRI (1=input, 0=output)
 #ifndef XPAR_AXI_GPIO_0_BASEADDR
@@ -48,6 +64,19 @@
 #define GPIO_DATA   (GPIO_BASE + 0x00)
 #define GPIO_TRI    (GPIO_BASE + 0x04)
 
+// ---------------- Shared-memory mailbox (optional) ----------------
+// -DPLL_USE_MAILBOX publishes out_f/theta to the Linux side instead of relying
+// on UART scraping. PLL_MBOX_BASE_ADDR must point at memory both cores map
+// (OCM or a reserved DDR carve-out).
+#ifdef PLL_USE_MAILBOX
+  #ifndef PLL_MBOX_BASE_ADDR
+    #error "PLL_USE_MAILBOX needs PLL_MBOX_BASE_ADDR (shared OCM/DDR region)."
+  #endif
+  #ifndef PLL_MBOX_DECIM
+    #define PLL_MBOX_DECIM  40      // one record per 1 ms @ 40 kHz
+  #endif
+#endif
+
 static inline void probe_init(void) { Xil_Out32(GPIO_TRI, 0x0); } // all outputs
 static inline void probe_hi(void)   { Xil_Out32(GPIO_DATA, 0x1); }
 static inline void probe_lo(void)   { Xil_Out32(GPIO_DATA, 0x0); }
@@ -101,6 +130,12 @@ int main()
 
     xil_printf("\r\n=== SW PLL benchmark (HDL-compatible I/O) + SETTLE ===\r\n");
     xil_printf("BRAM_BASE = 0x%08lx\r\n", (unsigned long)BRAM_BASE_ADDR);
+    xil_printf("PLL profile = %s  engine = %s\r\n", PLL_PROFILE_NAME, PLL_ENGINE_NAME);
+#ifdef PLL_USE_TCM
+    xil_printf("hot path in TCM: step @ 0x%08lx\r\n", (unsigned long)(uintptr_t)&PLL_ENGINE_STEP_FN);
+#else
+    xil_printf("hot path in default sections: step @ 0x%08lx\r\n", (unsigned long)(uintptr_t)&PLL_ENGINE_STEP_FN);
+#endif
 
     volatile uint32_t *bram = (volatile uint32_t*)BRAM_BASE_ADDR;
 
@@ -124,8 +159,16 @@ int main()
     dump_word("SINE", 768, bram[768]); // -1.0 -> 0xFFC00000
 
     // 3) PLL init (kp=0.5, ki=0.00125 in Q2.30)
-    pll_q30_state_t st;
-    pll_q30_init(&st, 0x20000000, 0x00147AE1);
+    // Engine is a compile-time choice (-DPLL_ENGINE=PLL_ENGINE_Q15/F32/Q30W, pll_engine.h)
+    pll_engine_state_t st;
+    pll_q30_state_t view;     // Q30-format copy for non-Q30 engines
+    pll_engine_init(&st, 0x20000000, 0x00147AE1);
+
+#ifdef PLL_USE_MAILBOX
+    pll_mbox_t *mbox = (pll_mbox_t*)PLL_MBOX_BASE_ADDR;
+    pll_mbox_init(mbox);
+    pll_mbox_push(mbox, PLL_MBOX_EV_RESET, pll_engine_view(&st, &view));
+#endif
 
     // ---------------- Input frequency emulation (phase accumulator) ----------------
     // We want FIN_HZ at FS_HZ using 1024-LUT in BRAM.
@@ -145,8 +188,15 @@ int main()
     for (int i=0; i<SETTLE_SAMPLES; i++) {
         uint32_t idx = phase >> (32 - 10);       // 0..1023
         int32_t  x_q22 = (int32_t)bram[idx];     // "ADC" sample in Q22
-        pll_q30_step(&st, x_q22);         // senin HDL-uyumlu step fonksiyonun
+        pll_engine_step(&st, x_q22);      // senin HDL-uyumlu step fonksiyonun
         phase += phase_step;
+#ifdef PLL_USE_MAILBOX
+        if ((i % PLL_MBOX_DECIM) == 0) {
+            const pll_q30_state_t *v = pll_engine_view(&st, &view);
+            pll_mbox_push(mbox, PLL_MBOX_EV_SAMPLE, v);
+            pll_mbox_publish_status(mbox, v, (uint64_t)i + 1u);
+        }
+#endif
     }
 
     // 5) BENCHMARK
@@ -159,7 +209,7 @@ int main()
     for (int i=0; i<N; i++) {
         uint32_t idx = phase >> (32 - 10);
         int32_t  x_q22 = (int32_t)bram[idx];
-        pll_q30_step(&st, x_q22);
+        pll_engine_step(&st, x_q22);
         phase += phase_step;
     }
 
@@ -167,32 +217,125 @@ int main()
     probe_lo();
 
     uint64_t cyc = (t1 - t0);
+
+#ifdef PLL_USE_MAILBOX
+    pll_mbox_publish_status(mbox, pll_engine_view(&st, &view), (uint64_t)(SETTLE_SAMPLES + N));
+#endif
     xil_printf("cycles = %lu (N=%d)  cycles/sample = %lu\r\n",
                (unsigned long)cyc, N, (unsigned long)(cyc / (uint64_t)N));
 
+#ifdef PLL_BENCH_BRAM_OUT
+    // 5b) Output path: per-sample volatile stores vs batched blocks
+    {
+        static pll_bram_out_t bo;
+        volatile uint32_t *octl = (volatile uint32_t*)BRAM_OUT_BASE_ADDR;
+
+        t0 = rdcycle64();
+        for (int i=0; i<N; i++) {
+            int32_t x_q22 = (int32_t)bram[phase >> (32 - 10)];
+            pll_engine_step(&st, x_q22);
+            pll_bram_out_put_direct(BRAM_OUT_BASE_ADDR, (uint32_t)i, pll_engine_view(&st, &view));
+            phase += phase_step;
+        }
+        t1 = rdcycle64();
+        uint64_t cyc_direct = t1 - t0;
+
+        pll_bram_out_init(&bo, BRAM_OUT_BASE_ADDR);
+        t0 = rdcycle64();
+        for (int i=0; i<N; i++) {
+            int32_t x_q22 = (int32_t)bram[phase >> (32 - 10)];
+            pll_engine_step(&st, x_q22);
+            if (pll_bram_out_put(&bo, pll_engine_view(&st, &view)) != 0) { octl[3] = 0; octl[4] = 0; } // self-consume
+            phase += phase_step;
+        }
+        t1 = rdcycle64();
+        uint64_t cyc_batched = t1 - t0;
+
+        xil_printf("BRAM out: per-sample cycles/sample = %lu  batched(%d) cycles/sample = %lu\r\n",
+                   (unsigned long)(cyc_direct / (uint64_t)N), (int)PLL_BRAM_OUT_BLOCK_N,
+                   (unsigned long)(cyc_batched / (uint64_t)N));
+    }
+#endif
+
+#ifdef PLL_BENCH_BIQUAD
+    // 5c) Biquad cascade: cycles per sample for 0..PLL_BQ_MAX sections (the
+    //     step from n to n + 1 is the cost of one section), then the Q30 loop
+    //     with three notches before the PI against the plain step
+    {
+        static const pll_bq_coef_t lfc[] = {
+            PLL_BQ_NOTCH(100.0, 2.0), PLL_BQ_NOTCH(200.0, 2.0), PLL_BQ_NOTCH(300.0, 2.0), PLL_BQ_LPF(2000.0, 0.7071)
+        };
+        static pll_bq_cascade_t bq;
+        volatile int32_t sink = 0;
+        uint64_t cyc_prev = 0;
+
+        for (uint32_t ns = 0; ns <= sizeof lfc / sizeof lfc[0] && ns <= PLL_BQ_MAX; ns++) {
+            pll_bq_init(&bq, lfc, ns);
+            t0 = rdcycle64();
+            for (int i=0; i<N; i++) {
+                int32_t x_q30 = (int32_t)((uint32_t)bram[phase >> (32 - 10)] << PLL_X_SHIFT);
+                sink = pll_bq_run(&bq, x_q30);
+                phase += phase_step;
+            }
+            t1 = rdcycle64();
+            uint64_t cyc_bq = t1 - t0;
+            xil_printf("biquad x%lu: cycles/sample = %lu", (unsigned long)ns, (unsigned long)(cyc_bq / (uint64_t)N));
+            if (ns) xil_printf("  cycles/section = %lu", (unsigned long)((cyc_bq - cyc_prev) / (uint64_t)N));
+            xil_printf("\r\n");
+            cyc_prev = cyc_bq;
+        }
+        (void)sink;
+
+#if PLL_LOOP_FILTER
+        pll_q30_state_t q;
+        pll_q30_init(&q, 0x20000000, 0x00147AE1);
+        t0 = rdcycle64();
+        for (int i=0; i<N; i++) {
+            pll_q30_step(&q, (int32_t)bram[phase >> (32 - 10)]);
+            phase += phase_step;
+        }
+        t1 = rdcycle64();
+        uint64_t cyc_plain = t1 - t0;
+
+        pll_bq_init(&bq, lfc, 3);
+        t0 = rdcycle64();
+        for (int i=0; i<N; i++) {
+            pll_q30_step_lf(&q, &bq, (int32_t)bram[phase >> (32 - 10)]);
+            phase += phase_step;
+        }
+        t1 = rdcycle64();
+        uint64_t cyc_lf = t1 - t0;
+
+        xil_printf("q30 step cycles/sample = %lu  step_lf(3 notches) cycles/sample = %lu\r\n",
+                   (unsigned long)(cyc_plain / (uint64_t)N), (unsigned long)(cyc_lf / (uint64_t)N));
+#endif
+    }
+#endif
+
     // 6) End state print (measurement dışı)
+    const pll_q30_state_t *pv = pll_engine_view(&st, &view);
     xil_printf("theta_q30=0x%08lx  sin=0x%08lx cos=0x%08lx  Out_f(Q25)=0x%08lx\r\n",
-               (unsigned long)st.theta_q30,
-               (unsigned long)st.sin_q30,
-               (unsigned long)st.cos_q30,
-               (unsigned long)st.out_f_q25);
+               (unsigned long)pv->theta_q30,
+               (unsigned long)pv->sin_q30,
+               (unsigned long)pv->cos_q30,
+               (unsigned long)pv->out_f_q25);
     // 6) End state
     xil_printf("theta_q30=0x%08lx  sin=0x%08lx cos=0x%08lx  Out_f(Q25)=0x%08lx\r\n",
-               (unsigned long)st.theta_q30,
-               (unsigned long)st.sin_q30,
-               (unsigned long)st.cos_q30,
-               (unsigned long)st.out_f_q25);
+               (unsigned long)pv->theta_q30,
+               (unsigned long)pv->sin_q30,
+               (unsigned long)pv->cos_q30,
+               (unsigned long)pv->out_f_q25);
 
     // Print interpretations:
     // theta: Q30 in turns
-    print_qn("theta(turn)", (int32_t)st.theta_q30, 30); xil_printf("\r\n");
+    print_qn("theta(turn)", (int32_t)pv->theta_q30, 30); xil_printf("\r\n");
 
     // sin/cos: Q30
-    print_qn("sin", st.sin_q30, 30); xil_printf("   ");
-    print_qn("cos", st.cos_q30, 30); xil_printf("\r\n");
+    print_qn("sin", pv->sin_q30, 30); xil_printf("   ");
+    print_qn("cos", pv->cos_q30, 30); xil_printf("\r\n");
 
     // Out_f: Q25 in Hz (HDL-compatible)
-    print_qn("Out_f(Hz)", st.out_f_q25, 25); xil_printf("\r\n");
+    print_qn("Out_f(Hz)", pv->out_f_q25, 25); xil_printf("\r\n");
 
     
     cleanup_platform();
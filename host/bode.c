@@ -0,0 +1,247 @@
+// Measured closed-loop frequency response of the PLL engine.
+//
+// The stimulus is the nominal sine with a small sinusoidal modulation at fm:
+//   FM: f(t)     = f0 + dev * cos(2 pi fm t)              (dev in Hz)
+//   PM: phase(t) = f0 t + dev * sin(2 pi fm t)            (dev in turns)
+// Both give an input frequency deviation X * cos(2 pi fm t). The loop is
+// locked once on the bare carrier (WARMUP_S); per point the modulation then
+// runs settle_s seconds and out_f is demodulated synchronously at fm over a
+// window of whole seconds (an integer number of modulation and ripple
+// periods, fm snapped to that grid and kept off multiples of f0, where the
+// phase-detector ripple sits). H(fm) = Y / X is reported as magnitude/phase.
+// For a PLL the input-phase -> output-phase and the input-frequency ->
+// out_f transfers are the same H. With -model the linearised response of
+// pll_q30_model.h (input frequency -> out_f) is printed alongside. -fe runs
+// the stimulus through the ADC front-end model (pll_frontend.h), so offset,
+// INL and jitter show up in the measured response.
+//
+// The engine is whatever pll_engine.h selects (-DPLL_ENGINE=...), i.e. the
+// real fixed-point step with its Q formats and shifts, so a scaling mistake
+// shows up as a wrong bandwidth or gain. Frequency points run in parallel.
+//
+// Build: cc -O2 -pthread -I.. -o bode bode.c pll_q30_model.c pll_frontend.c ../pll_q30.c -lm
+// Run  : ./bode [-k kp_q30 ki_q30] [-a amp] [-m fm|pm] [-d dev] [-f fmin fmax]
+//               [-p points] [-s settle_s] [-j threads] [-model] [-fe board|spec] [-csv file]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "pll_config.h"
+#include "pll_engine.h"
+#include "pll_q30_model.h"
+#include "pll_frontend.h"
+
+#define WARMUP_S   30           // pull-in on the bare carrier, shared by all points
+#define MAX_PTS    256
+#define BLK        1024         // stimulus block through the front end
+
+typedef struct {
+    double fm;                  // snapped modulation frequency
+    int    window_s;
+    double mag, phase_deg;
+    double model_mag, model_deg;
+} point_t;
+
+static int32_t kp = 0x20000000, ki = 0x00147AE1;
+static double  amp = 0.9, f0 = 50.0, dev = -1.0;
+static int     pm;              // 0: FM, 1: PM
+static int     settle_s = 10;   // modulation on, before the measurement window
+static int     model;           // -model: overlay pll_q30_model.h
+static pll_fe_t fe;             // ADC front end, ideal by default
+static pll_engine_state_t warm; // locked state after WARMUP_S
+static double  warm_ph;         // input phase (turns) at that point
+static point_t pts[MAX_PTS];
+static int     npts, next_pt;
+
+// fm onto the 1/T grid of its window (T whole seconds), off the f0 harmonics
+static double snap_fm(double fm_req, int *window_s)
+{
+    int    T  = (int)ceil(fmax(2.0, 4.0 / fm_req));
+    double fm = round(fm_req * T) / T;
+    if (fm <= 0.0) fm = 1.0 / T;
+    double r = fmod(fm, f0);
+    if (r < 0.5 / T || f0 - r < 0.5 / T) fm += 1.0 / T;
+    *window_s = T;
+    return fm;
+}
+
+static void measure(point_t *p)
+{
+    const double fs = PLL_FS_HZ;
+    const double fm = p->fm;
+    const int    T  = p->window_s;
+
+    // input frequency deviation amplitude (Hz), phase reference cos(2 pi fm t)
+    double X = pm ? 2.0 * M_PI * fm * dev : dev;
+
+    pll_engine_state_t st = warm;
+    double   ph = warm_ph, I = 0.0, Q = 0.0;
+    double   v[BLK], dv[BLK];
+    int32_t  x[BLK];
+    uint64_t rng = 0x5EED + (uint64_t)(p - pts);
+    long     n0 = (long)settle_s * PLL_FS_HZ, n1 = n0 + (long)T * PLL_FS_HZ;
+    for (long b = 0; b < n1; b += BLK) {
+        int m = (n1 - b < BLK) ? (int)(n1 - b) : BLK;
+        for (int k = 0; k < m; k++) {
+            double t = (b + k) / fs, turns, f;
+            if (pm) {
+                turns = warm_ph + f0 * t + dev * sin(2.0 * M_PI * fm * t);
+                turns -= floor(turns);
+                f = f0 + 2.0 * M_PI * fm * dev * cos(2.0 * M_PI * fm * t);
+            } else {
+                turns = ph;
+                f = f0 + dev * cos(2.0 * M_PI * fm * t);
+                ph += f / fs;
+                ph -= floor(ph);
+            }
+            v[k]  = amp * sin(2.0 * M_PI * turns);
+            dv[k] = 2.0 * M_PI * f * amp * cos(2.0 * M_PI * turns);
+        }
+        pll_fe_convert(&fe, &rng, v, dv, x, (size_t)m);
+        for (int k = 0; k < m; k++) {
+            long i = b + k;
+            pll_engine_step(&st, x[k]);
+            if (i >= n0) {
+                // out_f after step i against the input frequency of sample i
+                // (which sets the phase of sample i + 1), as in the model
+                double y = pll_engine_out_f_q25(&st) / 33554432.0 - f0;
+                double w = 2.0 * M_PI * fm * i / fs;
+                I += y * cos(w);
+                Q += y * sin(w);
+            }
+        }
+    }
+    double N = (double)(n1 - n0);
+    double yr = 2.0 * I / N, yi = -2.0 * Q / N;             // Y = |Y| e^{j phi}
+    p->mag = hypot(yr, yi) / X;
+    p->phase_deg = atan2(yi, yr) * 180.0 / M_PI;
+}
+
+static void *worker(void *arg)
+{
+    (void)arg;
+    for (;;) {
+        int i = __atomic_fetch_add(&next_pt, 1, __ATOMIC_RELAXED);
+        if (i >= npts) return NULL;
+        measure(&pts[i]);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    long   nthreads = sysconf(_SC_NPROCESSORS_ONLN);
+    double fmin = 0.1, fmax_ = 200.0;
+    const char *csv = NULL;
+    npts = 40;
+
+    for (int i = 1; i < argc; i++) {
+        if      (!strcmp(argv[i], "-k") && i + 2 < argc) { kp = (int32_t)strtol(argv[i + 1], NULL, 0);
+                                                          ki = (int32_t)strtol(argv[i + 2], NULL, 0); i += 2; }
+        else if (!strcmp(argv[i], "-a") && i + 1 < argc) amp = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-m") && i + 1 < argc) pm = !strcmp(argv[++i], "pm");
+        else if (!strcmp(argv[i], "-d") && i + 1 < argc) dev = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-f") && i + 2 < argc) { fmin = atof(argv[i + 1]); fmax_ = atof(argv[i + 2]); i += 2; }
+        else if (!strcmp(argv[i], "-p") && i + 1 < argc) npts = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) settle_s = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-j") && i + 1 < argc) nthreads = atol(argv[++i]);
+        else if (!strcmp(argv[i], "-model")) model = 1;
+        else if (!strcmp(argv[i], "-fe") && i + 1 < argc) {
+            if (pll_fe_parse(&fe, argv[++i]) != 0) { fprintf(stderr, "bad front-end spec: %s\n", argv[i]); return 2; }
+        }
+        else if (!strcmp(argv[i], "-csv") && i + 1 < argc) csv = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [-k kp_q30 ki_q30] [-a amp] [-m fm|pm] [-d dev] [-f fmin fmax]\n"
+                            "          [-p points] [-s settle_s] [-j threads] [-model] [-fe board|spec] [-csv file]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    if (dev < 0.0) dev = pm ? 0.002 : 0.02;                  // small-signal defaults
+    if (npts < 1) npts = 1;
+    if (npts > MAX_PTS) npts = MAX_PTS;
+    if (fmin <= 0.0 || fmax_ <= fmin) { fmin = 0.1; fmax_ = 200.0; }
+    if (nthreads < 1) nthreads = 1;
+    if (nthreads > 64) nthreads = 64;
+    if (settle_s < 0) settle_s = 0;
+
+    // lock once on the bare carrier; every point starts from this state
+    pll_engine_init(&warm, kp, ki);
+    {
+        int32_t  x[BLK];
+        uint64_t rng = 0x5EED;
+        for (long b = 0; b < (long)WARMUP_S * PLL_FS_HZ; b += BLK) {
+            warm_ph = pll_fe_sine(&fe, &rng, amp, f0, PLL_FS_HZ, warm_ph, x, BLK);
+            for (int k = 0; k < BLK; k++) pll_engine_step(&warm, x[k]);
+        }
+    }
+
+    // log-spaced, snapped; neighbours that snap onto the same (or a lower)
+    // frequency are dropped so the table is strictly increasing
+    int req = npts;
+    npts = 0;
+    for (int i = 0; i < req; i++) {
+        int    T;
+        double fm = snap_fm(fmin * pow(fmax_ / fmin, req > 1 ? (double)i / (req - 1) : 0.0), &T);
+        if (npts && fm <= pts[npts - 1].fm) continue;
+        pts[npts].fm = fm;
+        pts[npts].window_s = T;
+        npts++;
+    }
+
+    pthread_t th[64];
+    for (long t = 0; t < nthreads; t++) pthread_create(&th[t], NULL, worker, NULL);
+    for (long t = 0; t < nthreads; t++) pthread_join(th[t], NULL);
+
+    pll_q30_model_t lm;
+    if (model && pll_q30_model_build(&lm, kp, ki, amp, PLL_FS_HZ, 1) != 0) model = 0;
+    for (int i = 0; model && i < npts; i++)
+        pll_q30_model_resp(&lm, PLL_MODEL_FF, pts[i].fm, &pts[i].model_mag, &pts[i].model_deg);
+
+    printf("engine %s, kp_q30 0x%08X ki_q30 0x%08X, amp %.3f, %s dev %g %s, f0 %.1f Hz, Fs %d Hz\n",
+           PLL_ENGINE_NAME, (unsigned)kp, (unsigned)ki, amp, pm ? "PM" : "FM", dev, pm ? "turns" : "Hz",
+           f0, PLL_FS_HZ);
+    char fe_desc[256];
+    pll_fe_describe(&fe, fe_desc, sizeof fe_desc);
+    printf("front end: %s\n", fe_desc);
+    if (npts < req) printf("%d of %d points coincide after snapping, dropped\n", req - npts, req);
+    if (model) printf("%10s %10s %10s %10s %10s\n", "fm [Hz]", "|H| [dB]", "arg [deg]", "model dB", "model deg");
+    else       printf("%10s %10s %10s  |H|\n", "fm [Hz]", "|H| [dB]", "arg [deg]");
+
+    double bw3 = 0.0, peak = -1e9, peak_f = 0.0;
+    for (int i = 0; i < npts; i++) {
+        double db = 20.0 * log10(pts[i].mag);
+        int bar = (int)((db + 40.0) * 1.5);
+        if (bar < 0) bar = 0;
+        if (bar > 70) bar = 70;
+        if (model)
+            printf("%10.3f %10.2f %10.1f %10.2f %10.1f\n", pts[i].fm, db, pts[i].phase_deg,
+                   20.0 * log10(pts[i].model_mag), pts[i].model_deg);
+        else
+            printf("%10.3f %10.2f %10.1f  %.*s\n", pts[i].fm, db, pts[i].phase_deg, bar,
+                   "======================================================================");
+        if (db > peak) { peak = db; peak_f = pts[i].fm; }
+        if (bw3 == 0.0 && i > 0 && db < -3.0 && 20.0 * log10(pts[i - 1].mag) >= -3.0)
+            bw3 = pts[i].fm;
+    }
+    printf("peak %.2f dB at %.3f Hz; first -3 dB crossing %s", peak, peak_f, bw3 > 0.0 ? "" : "not found\n");
+    if (bw3 > 0.0) printf("near %.3f Hz\n", bw3);
+
+    if (csv) {
+        FILE *f = fopen(csv, "w");
+        if (!f) { perror(csv); return 1; }
+        fprintf(f, "fm_hz,mag_db,phase_deg,window_s%s\n", model ? ",model_db,model_deg" : "");
+        for (int i = 0; i < npts; i++) {
+            fprintf(f, "%.6f,%.4f,%.3f,%d", pts[i].fm, 20.0 * log10(pts[i].mag), pts[i].phase_deg,
+                    pts[i].window_s);
+            if (model) fprintf(f, ",%.4f,%.3f", 20.0 * log10(pts[i].model_mag), pts[i].model_deg);
+            fputc('\n', f);
+        }
+        fclose(f);
+    }
+    return 0;
+}
@@ -0,0 +1,257 @@
+// Accuracy and cost of the PLL engines against the Q30 reference on the same
+// stimulus.
+//
+// Stimulus: 50 Hz, then a step to FSTEP_HZ at t = 1 s, amplitude AMP, passed
+// through the ADC front-end model (pll_frontend.h; default: ideal adc_bits
+// quantizer, -fe board / key=value for the board impairments) and fed to
+// every engine from the same Q22 samples.
+// Reports out_f error of each engine relative to pll_q30 (settled window and
+// whole run) and host time per sample. Also checks that the multi-channel
+// Q15 bank kernel is bit-exact with pll_q15_step. Last, pll_q30 on irregular
+// sampling (spacing 1/Fs +-JITTER_FRAC, times known): error of out_f averaged
+// over 10 ms windows (the 2f ripple of the placeholder detector cancels)
+// against the true frequency, fixed-rate step vs pll_q30_step_block_ts.
+//
+// Build: cc -O2 -I.. -o engine_compare engine_compare.c pll_frontend.c ../pll_q30.c ../pll_q30w.c
+//           ../pll_q15.c ../pll_f32.c -lm
+// Run  : ./engine_compare [adc_bits] [-fe board|spec]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "pll_q30.h"
+#include "pll_q15.h"
+#include "pll_f32.h"
+#include "pll_q30w.h"
+#include "pll_config.h"
+#include "pll_frontend.h"
+
+#define KP_Q30     0x20000000
+#define KI_Q30     0x00147AE1
+#define SECONDS    3
+#define N          (SECONDS * PLL_FS_HZ)
+#define T_STEP     (1 * PLL_FS_HZ)
+#define SETTLE     (2 * PLL_FS_HZ)       // error stats after this sample
+#define FSTEP_HZ   50.5
+#define AMP        0.9
+#define JITTER_FRAC 0.2                  // irregular-sampling section:
+#define NI         (10 * PLL_FS_HZ)      //   run length
+#define SETTLE_I   (8 * PLL_FS_HZ)       //   after the pull-in ringing
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+typedef struct {
+    double sum2, sum, maxabs;
+    long   n;
+} err_t;
+
+static void err_add(err_t *e, double d)
+{
+    e->sum2 += d * d;
+    e->sum  += d;
+    if (fabs(d) > e->maxabs) e->maxabs = fabs(d);
+    e->n++;
+}
+
+static void err_print(const char *name, const err_t *all, const err_t *settled, double ns)
+{
+    printf("%-6s | rms %10.6f  max %10.6f | settled rms %10.6f  mean %+10.6f  max %10.6f | %7.2f ns/smp\n",
+           name, sqrt(all->sum2 / all->n), all->maxabs,
+           sqrt(settled->sum2 / settled->n), settled->sum / settled->n, settled->maxabs, ns);
+}
+
+int main(int argc, char **argv)
+{
+    int adc_bits = 12;
+    pll_fe_t fe;
+    const char *fe_spec = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-fe") && i + 1 < argc) fe_spec = argv[++i];
+        else adc_bits = atoi(argv[i]);
+    }
+    if (adc_bits < 4 || adc_bits > 23) adc_bits = 12;
+    fe = PLL_FE_IDEAL;
+    fe.bits = adc_bits;
+    if (fe_spec && pll_fe_parse(&fe, fe_spec) != 0) {
+        fprintf(stderr, "bad front-end spec: %s\n", fe_spec);
+        return 2;
+    }
+
+    // ---- stimulus (shared, Q22) ----
+    int32_t *x_q22 = malloc(sizeof(int32_t) * N);
+    int16_t *x_q15 = malloc(sizeof(int16_t) * N);
+    int32_t *f_ref = malloc(sizeof(int32_t) * N);
+    if (!x_q22 || !x_q15 || !f_ref) return 1;
+
+    uint64_t rng = 0x5EED;
+    double ph = pll_fe_sine(&fe, &rng, AMP, 50.0, PLL_FS_HZ, 0.0, x_q22, T_STEP);
+    pll_fe_sine(&fe, &rng, AMP, FSTEP_HZ, PLL_FS_HZ, ph, x_q22 + T_STEP, N - T_STEP);
+    for (int i = 0; i < N; i++) x_q15[i] = pll_q15_from_q22(x_q22[i]);
+
+    char fe_desc[256];
+    pll_fe_describe(&fe, fe_desc, sizeof fe_desc);
+    printf("stimulus: 50 Hz -> %.2f Hz at %d s, amp %.2f, %d s @ %d Hz\nfront end: %s\n",
+           FSTEP_HZ, T_STEP / PLL_FS_HZ, AMP, SECONDS, PLL_FS_HZ, fe_desc);
+    printf("out_f error vs pll_q30 in Hz\n");
+
+    // ---- Q30 reference ----
+    pll_q30_state_t q30;
+    pll_q30_init(&q30, KP_Q30, KI_Q30);
+    double t0 = now_ns();
+    for (int i = 0; i < N; i++) {
+        pll_q30_step(&q30, x_q22[i]);
+        f_ref[i] = q30.out_f_q25;
+    }
+    double ns_q30 = (now_ns() - t0) / N;
+    printf("%-6s | reference (final out_f %.6f Hz) | %7.2f ns/smp\n",
+           "q30", q30.out_f_q25 / 33554432.0, ns_q30);
+
+    // ---- Q15 ----
+    {
+        pll_q15_state_t q15;
+        err_t all = {0}, settled = {0};
+        pll_q15_init(&q15, KP_Q30, KI_Q30);
+        t0 = now_ns();
+        for (int i = 0; i < N; i++) pll_q15_step(&q15, x_q15[i]);
+        double ns = (now_ns() - t0) / N;
+
+        pll_q15_init(&q15, KP_Q30, KI_Q30);
+        for (int i = 0; i < N; i++) {
+            pll_q15_step(&q15, x_q15[i]);
+            double d = (q15.out_f_q25 - f_ref[i]) / 33554432.0;
+            err_add(&all, d);
+            if (i >= SETTLE) err_add(&settled, d);
+        }
+        err_print("q15", &all, &settled, ns);
+    }
+
+    // ---- float32 ----
+    {
+        pll_f32_state_t f32;
+        err_t all = {0}, settled = {0};
+        pll_f32_init(&f32, KP_Q30, KI_Q30);
+        t0 = now_ns();
+        for (int i = 0; i < N; i++) pll_f32_step(&f32, x_q22[i]);
+        double ns = (now_ns() - t0) / N;
+
+        pll_f32_init(&f32, KP_Q30, KI_Q30);
+        for (int i = 0; i < N; i++) {
+            pll_f32_step(&f32, x_q22[i]);
+            double d = (pll_f32_out_f_q25(&f32) - f_ref[i]) / 33554432.0;
+            err_add(&all, d);
+            if (i >= SETTLE) err_add(&settled, d);
+        }
+        err_print("f32", &all, &settled, ns);
+    }
+
+    // ---- Q30, 64-bit PI: identical until pll_q30 saturates (pull-in) ----
+    {
+        pll_q30w_state_t w;
+        err_t all = {0}, settled = {0};
+        pll_q30w_init(&w, KP_Q30, KI_Q30);
+        t0 = now_ns();
+        for (int i = 0; i < N; i++) pll_q30w_step(&w, x_q22[i]);
+        double ns = (now_ns() - t0) / N;
+
+        pll_q30w_init(&w, KP_Q30, KI_Q30);
+        for (int i = 0; i < N; i++) {
+            pll_q30w_step(&w, x_q22[i]);
+            double d = (w.out_f_q25 - f_ref[i]) / 33554432.0;
+            err_add(&all, d);
+            if (i >= SETTLE) err_add(&settled, d);
+        }
+        err_print("q30w", &all, &settled, ns);
+    }
+
+    // ---- Q30 on irregular sampling: fixed-rate step vs timestamps ----
+    {
+        uint64_t *t = malloc(sizeof(uint64_t) * (NI + 1));
+        double   *v = malloc(sizeof(double) * NI);
+        int32_t  *xi = malloc(sizeof(int32_t) * NI), *fo = malloc(sizeof(int32_t) * NI);
+        if (!t || !v || !xi || !fo) return 1;
+        uint64_t rng = 0x5EED, s = 0x1234;
+        double   ts = 0.0;
+        for (int i = 0; i <= NI; i++) {
+            s = s * 6364136223846793005ull + 1442695040888963407ull;
+            double u = (double)(s >> 11) * 0x1.0p-53 * 2.0 - 1.0;
+            t[i] = (uint64_t)llround(ts * 4294967296.0);
+            if (i < NI) v[i] = AMP * sin(2.0 * M_PI * FSTEP_HZ * t[i] / 4294967296.0);
+            ts += (1.0 + JITTER_FRAC * u) / PLL_FS_HZ;
+        }
+        pll_fe_convert(&fe, &rng, v, NULL, xi, NI);
+
+        err_t fixed = {0}, stamped = {0};
+        double sa = 0.0, sb = 0.0;
+        const int W = PLL_FS_HZ / 100;
+        pll_q30_state_t a, b;
+        pll_q30_init(&a, KP_Q30, KI_Q30);
+        pll_q30_init(&b, KP_Q30, KI_Q30);
+        t0 = now_ns();
+        pll_q30_step_block_ts(&b, xi, t, fo, NI);
+        double ns = (now_ns() - t0) / NI;
+        for (int i = 0; i < NI; i++) {
+            pll_q30_step(&a, xi[i]);
+            if (i < SETTLE_I) continue;
+            sa += a.out_f_q25 / 33554432.0;
+            sb += fo[i] / 33554432.0;
+            if ((i - SETTLE_I) % W == W - 1) {
+                err_add(&fixed, sa / W - FSTEP_HZ);
+                err_add(&stamped, sb / W - FSTEP_HZ);
+                sa = sb = 0.0;
+            }
+        }
+        printf("q30 irregular sampling (1/Fs +-%.0f%%), last 2 s, 10 ms mean out_f - %.2f Hz:\n"
+               "       fixed-rate rms %.6f mean %+.6f | timestamped rms %.6f mean %+.6f | %7.2f ns/smp\n",
+               100.0 * JITTER_FRAC, FSTEP_HZ, sqrt(fixed.sum2 / fixed.n), fixed.sum / fixed.n,
+               sqrt(stamped.sum2 / stamped.n), stamped.sum / stamped.n, ns);
+        free(t); free(v); free(xi); free(fo);
+    }
+
+    // ---- Q15 bank: bit-exact with the scalar kernel, channel 0 = stimulus ----
+    {
+        static pll_q15_bank_t bank;
+        pll_q15_state_t ref[PLL_Q15_BANK_N];
+        int16_t xb[PLL_Q15_BANK_N];
+        long mismatches = 0;
+
+        pll_q15_bank_init(&bank, KP_Q30, KI_Q30);
+        for (int c = 0; c < PLL_Q15_BANK_N; c++) pll_q15_init(&ref[c], KP_Q30, KI_Q30);
+
+        t0 = now_ns();
+        for (int i = 0; i < N; i++) {
+            for (int c = 0; c < PLL_Q15_BANK_N; c++)          // per-channel phase offsets
+                xb[c] = x_q15[(i + 97 * c) % N];
+            pll_q15_bank_step(&bank, xb);
+        }
+        double ns = (now_ns() - t0) / ((double)N * PLL_Q15_BANK_N);
+
+        pll_q15_bank_init(&bank, KP_Q30, KI_Q30);
+        for (int i = 0; i < N; i++) {
+            for (int c = 0; c < PLL_Q15_BANK_N; c++) {
+                xb[c] = x_q15[(i + 97 * c) % N];
+                pll_q15_step(&ref[c], xb[c]);
+            }
+            pll_q15_bank_step(&bank, xb);
+            for (int c = 0; c < PLL_Q15_BANK_N; c++)
+                if (bank.out_f_q25[c] != ref[c].out_f_q25 || bank.theta_q30[c] != ref[c].theta_q30)
+                    mismatches++;
+        }
+        printf("q15 bank x%d: %ld mismatches vs pll_q15_step | %7.2f ns/smp/channel\n",
+               PLL_Q15_BANK_N, mismatches, ns);
+        if (mismatches) return 1;
+    }
+
+    free(x_q22);
+    free(x_q15);
+    free(f_ref);
+    return 0;
+}
@@ -0,0 +1,278 @@
+// Per-stage error budget of pll_q30_step against an exact (double) loop.
+//
+// The loop is modelled once, with each precision-limiting stage switchable
+// between its fixed-point form (as in pll_q30_step) and an exact form:
+//   NCO   : 10-bit theta index into the Q30 table   vs  sin/cos(2*pi*theta)
+//   INPUT : Q22 input word                          vs  the analog value
+//   MUL   : Q30 products/sums (mul_q30, sat32) and  vs  double products
+//           the Q30 -> Q25 out_f truncation
+//   INC   : INV_FS_Q32 rounding, >> 27 truncation   vs  theta += f / Fs
+//           and the Q30 phase accumulator
+// Saturation at +-2.0 (the sat32 range) is behaviour, not precision, and is
+// kept in every variant. With every stage fixed the model is bit-exact with
+// pll_q30_step (checked at start-up).
+//
+// For each stimulus the exact loop is the reference. Reported per stage:
+//   alone   : out_f error with only that stage fixed (its own contribution)
+//   upgrade : error of the full fixed loop with only that stage made exact
+//             (what upgrading it would buy)
+// Variants x stimuli run in parallel threads.
+//
+// Build: cc -O2 -pthread -I.. -o error_budget error_budget.c ../pll_q30.c -lm
+// Run  : ./error_budget [threads]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "pll_q30.h"
+#include "pll_config.h"
+#include "pll_fixed.h"
+#include "sine_q230_1024.h"
+
+#define KP_Q30     0x20000000
+#define KI_Q30     0x00147AE1
+#define SECONDS    3
+#define N          (SECONDS * PLL_FS_HZ)
+#define SETTLE     (2 * PLL_FS_HZ)
+
+#define ST_NCO     (1u << 0)
+#define ST_INPUT   (1u << 1)
+#define ST_MUL     (1u << 2)
+#define ST_INC     (1u << 3)
+#define ST_ALL     (ST_NCO | ST_INPUT | ST_MUL | ST_INC)
+#define N_STAGES   4
+
+static const char *const stage_name[N_STAGES] = { "NCO", "INPUT", "MUL", "INC" };
+
+#define Q30        1073741824.0
+#define Q25        33554432.0
+#define Q22        4194304.0
+
+// ---------- stimuli ----------
+typedef struct {
+    const char *name;
+    double f0, f1;        // Hz before / after t = 1 s
+    double amp;
+    double h3;            // 3rd harmonic, relative
+} stim_t;
+
+static const stim_t stims[] = {
+    { "50 Hz, 0.9 FS",            50.0, 50.0, 0.9, 0.0  },
+    { "50 Hz, 0.1 FS",            50.0, 50.0, 0.1, 0.0  },
+    { "49.5 Hz, 0.9 FS",          49.5, 49.5, 0.9, 0.0  },
+    { "step 50 -> 50.5 Hz",       50.0, 50.5, 0.9, 0.0  },
+    { "50.2 Hz + 5% 3rd harm.",   50.2, 50.2, 0.9, 0.05 },
+};
+#define N_STIM ((int)(sizeof stims / sizeof stims[0]))
+
+static void make_input(const stim_t *s, double *x)
+{
+    double ph = 0.0;
+    for (int i = 0; i < N; i++) {
+        double f = (i < PLL_FS_HZ) ? s->f0 : s->f1;
+        x[i] = s->amp * (sin(2.0 * M_PI * ph) + s->h3 * sin(6.0 * M_PI * ph));
+        ph += f / PLL_FS_HZ;
+        ph -= floor(ph);
+    }
+}
+
+// ---------- switchable model ----------
+typedef struct {
+    unsigned fixed;       // ST_* bits: stage in fixed-point form
+    double   kp, ki;
+    double   integ;
+    double   theta;       // turns [0, 1), exact INC
+    uint32_t theta_q30;   // fixed INC
+} model_t;
+
+static double sat2(double v)          // sat32 range in Q30 units
+{
+    if (v >  2.0 - 1.0 / Q30) return 2.0 - 1.0 / Q30;
+    if (v < -2.0)             return -2.0;
+    return v;
+}
+
+static double mul(const model_t *m, double a, double b)
+{
+    if (!(m->fixed & ST_MUL)) return sat2(a * b);
+    int32_t A = pll_sat32_ref(llround(a * Q30)), B = pll_sat32_ref(llround(b * Q30));
+    return pll_mul_q30_ref(A, B) / Q30;
+}
+
+static void model_init(model_t *m, unsigned fixed)
+{
+    memset(m, 0, sizeof *m);
+    m->fixed = fixed;
+    m->kp = KP_Q30 / Q30;
+    m->ki = KI_Q30 / Q30;
+}
+
+// x: analog input value; returns out_f in Hz
+static double model_step(model_t *m, double x)
+{
+    // NCO
+    double th = (m->fixed & ST_INC) ? m->theta_q30 / Q30 : m->theta;
+    double s;
+    if (m->fixed & ST_NCO) {
+        uint32_t t = (m->fixed & ST_INC) ? m->theta_q30 : (uint32_t)(m->theta * Q30);
+        s = sine_q230[(t >> 20) & (SINE_N - 1)] / Q30;
+    } else {
+        s = sin(2.0 * M_PI * th);
+    }
+
+    // input
+    if (m->fixed & ST_INPUT) x = (double)(int32_t)lrint(x * Q22) / Q22;
+
+    // phase detector + PI
+    double qerr = -mul(m, x, s);
+    double p    = mul(m, m->kp, qerr);
+    m->integ    = sat2(m->integ + mul(m, m->ki, qerr));
+    double u    = sat2(p + m->integ);
+
+    // out_f (Q25 when fixed: u >> 5 truncates)
+    double delta = (m->fixed & ST_MUL) ? floor(u * Q25) / Q25 : u;
+    double f = 50.0 + delta;
+
+    // theta update
+    if (m->fixed & ST_INC) {
+        int32_t f_q25 = (int32_t)llround(f * Q25);
+        if (!(m->fixed & ST_MUL)) f_q25 = (int32_t)floor(f * Q25);
+        int32_t inc = (int32_t)(((int64_t)f_q25 * (int64_t)PLL_INV_FS_Q32) >> 27);
+        m->theta_q30 = pll_theta_add_q30(m->theta_q30, inc);
+    } else {
+        m->theta += f / PLL_FS_HZ;
+        m->theta -= floor(m->theta);
+    }
+    return f;
+}
+
+// ---------- jobs ----------
+typedef struct {
+    int      stim;
+    unsigned fixed;
+    double  *out_f;       // N values
+} job_t;
+
+static double  *inputs[N_STIM];
+static job_t   *jobs;
+static int      njobs, next_job;
+
+static void *worker(void *arg)
+{
+    (void)arg;
+    for (;;) {
+        int k = __atomic_fetch_add(&next_job, 1, __ATOMIC_RELAXED);
+        if (k >= njobs) return NULL;
+        model_t m;
+        model_init(&m, jobs[k].fixed);
+        const double *x = inputs[jobs[k].stim];
+        for (int i = 0; i < N; i++) jobs[k].out_f[i] = model_step(&m, x[i]);
+    }
+}
+
+static void err_stats(const double *a, const double *ref, double *rms, double *mean, double *maxabs)
+{
+    double s2 = 0.0, s = 0.0, mx = 0.0;
+    for (int i = SETTLE; i < N; i++) {
+        double d = a[i] - ref[i];
+        s2 += d * d;
+        s  += d;
+        if (fabs(d) > mx) mx = fabs(d);
+    }
+    *rms = sqrt(s2 / (N - SETTLE));
+    *mean = s / (N - SETTLE);
+    *maxabs = mx;
+}
+
+// all-fixed model == pll_q30_step, bit for bit
+static int self_check(const double *x)
+{
+    model_t m;
+    pll_q30_state_t st;
+    model_init(&m, ST_ALL);
+    pll_q30_init(&st, KP_Q30, KI_Q30);
+    for (int i = 0; i < N; i++) {
+        double f = model_step(&m, x[i]);
+        pll_q30_step(&st, (int32_t)lrint(x[i] * Q22));
+        if ((int32_t)llround(f * Q25) != st.out_f_q25) {
+            printf("self-check FAILED at sample %d: model %.9f Hz, pll_q30 %.9f Hz\n",
+                   i, f, st.out_f_q25 / Q25);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    long nthreads = (argc > 1) ? atol(argv[1]) : sysconf(_SC_NPROCESSORS_ONLN);
+    if (nthreads < 1) nthreads = 1;
+    if (nthreads > 64) nthreads = 64;
+
+    // variants: exact, all fixed, each stage alone, each stage upgraded
+    unsigned variants[2 + 2 * N_STAGES];
+    int nv = 0;
+    variants[nv++] = 0;
+    variants[nv++] = ST_ALL;
+    for (int s = 0; s < N_STAGES; s++) variants[nv++] = 1u << s;
+    for (int s = 0; s < N_STAGES; s++) variants[nv++] = ST_ALL & ~(1u << s);
+
+    for (int s = 0; s < N_STIM; s++) {
+        inputs[s] = malloc(sizeof(double) * N);
+        if (!inputs[s]) return 1;
+        make_input(&stims[s], inputs[s]);
+    }
+    if (self_check(inputs[0])) return 1;
+
+    njobs = N_STIM * nv;
+    jobs = calloc((size_t)njobs, sizeof *jobs);
+    if (!jobs) return 1;
+    for (int s = 0; s < N_STIM; s++)
+        for (int v = 0; v < nv; v++) {
+            job_t *j = &jobs[s * nv + v];
+            j->stim = s;
+            j->fixed = variants[v];
+            j->out_f = malloc(sizeof(double) * N);
+            if (!j->out_f) return 1;
+        }
+
+    pthread_t th[64];
+    for (long t = 0; t < nthreads; t++) pthread_create(&th[t], NULL, worker, NULL);
+    for (long t = 0; t < nthreads; t++) pthread_join(th[t], NULL);
+
+    printf("out_f error vs exact loop, settled window (%d..%d s), Hz; %d variants x %d stimuli, %ld threads\n",
+           SETTLE / PLL_FS_HZ, SECONDS, nv, N_STIM, nthreads);
+    double sum_alone[N_STAGES] = {0}, sum_upg[N_STAGES] = {0}, sum_all = 0.0;
+    for (int s = 0; s < N_STIM; s++) {
+        const double *ref = jobs[s * nv].out_f;
+        double rms, mean, mx;
+        err_stats(jobs[s * nv + 1].out_f, ref, &rms, &mean, &mx);
+        sum_all += rms;
+        printf("\n%s\n  %-18s rms %.3e  mean %+.3e  max %.3e\n", stims[s].name, "all fixed", rms, mean, mx);
+        for (int k = 0; k < N_STAGES; k++) {
+            double ra, ma, xa, ru, mu, xu;
+            err_stats(jobs[s * nv + 2 + k].out_f, ref, &ra, &ma, &xa);
+            err_stats(jobs[s * nv + 2 + N_STAGES + k].out_f, ref, &ru, &mu, &xu);
+            sum_alone[k] += ra;
+            sum_upg[k]   += ru;
+            printf("  %-6s alone      rms %.3e  mean %+.3e  max %.3e | upgrade -> rms %.3e\n",
+                   stage_name[k], ra, ma, xa, ru);
+        }
+    }
+
+    printf("\nsummary (mean over stimuli of settled rms, Hz): all fixed %.3e\n", sum_all / N_STIM);
+    for (int k = 0; k < N_STAGES; k++)
+        printf("  %-6s alone %.3e   upgrading it leaves %.3e (%5.1f%% of all-fixed)\n",
+               stage_name[k], sum_alone[k] / N_STIM, sum_upg[k] / N_STIM,
+               sum_all > 0.0 ? 100.0 * sum_upg[k] / sum_all : 0.0);
+
+    for (int k = 0; k < njobs; k++) free(jobs[k].out_f);
+    for (int s = 0; s < N_STIM; s++) free(inputs[s]);
+    free(jobs);
+    return 0;
+}
@@ -0,0 +1,439 @@
+// Bit-exactness proof for the fixed-point helpers and optimized kernels.
+//
+//  1. exhaustive: every input of a reduced domain (billions of cases)
+//  2. random:     properties over the full 32/64-bit domain
+//  3. differential: library pll_q30_step (as built, with whatever -D options)
+//     against a reference step written with the *_ref helpers, and the Q15
+//     bank kernel against pll_q15_step; pll_q30w against the reference up to
+//     the first sample on which a clamp it does not reproduce engages
+//  4. behaviour: pll_q30 and pll_q30w re-lock after an out-of-range
+//     excursion within RELOCK_MAX_S (no integrator windup)
+//
+// Work is split across threads; every test prints its case count and the
+// first failing input. Exit code is non-zero on any mismatch.
+//
+// Build: cc -O2 -pthread -I.. -o fixed_verify fixed_verify.c ../pll_q30.c ../pll_q30w.c ../pll_q15.c
+//        (repeat with -DPLL_FIXED_BRANCHLESS=1 -DPLL_FIXED_MULH=1,
+//         -DPLL_PROFILE_MINIMAL, ... to cover each library configuration)
+// Run  : ./fixed_verify [threads] [quick]
+//        quick: sample every 256th case of the exhaustive domains
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "pll_q30.h"
+#include "pll_q15.h"
+#include "pll_q30w.h"
+#include "pll_fixed.h"
+#include "pll_nco.h"
+#include "pll_q30_ref.h"
+
+#define RANDOM_CASES   (1ull << 28)
+#define STEP_STREAMS   4096
+#define STEP_LEN       4096
+
+// ---------- work distribution ----------
+typedef struct test_s test_t;
+typedef uint64_t (*chunk_fn)(const test_t *t, uint64_t lo, uint64_t hi, uint64_t *bad_case);
+
+struct test_s {
+    const char *name;
+    uint64_t    n;        // cases (indices 0..n-1)
+    uint64_t    stride;   // index step (quick mode)
+    chunk_fn    fn;
+};
+
+typedef struct {
+    const test_t *t;
+    uint64_t next;        // shared chunk cursor
+    uint64_t fails;
+    uint64_t first_bad;
+    pthread_mutex_t mu;
+} job_t;
+
+#define CHUNK (1ull << 22)
+
+static void *worker(void *arg)
+{
+    job_t *j = arg;
+    for (;;) {
+        uint64_t lo = __atomic_fetch_add(&j->next, CHUNK, __ATOMIC_RELAXED);
+        if (lo >= j->t->n) break;
+        uint64_t hi = (lo + CHUNK < j->t->n) ? lo + CHUNK : j->t->n;
+        uint64_t bad = 0;
+        uint64_t f = j->t->fn(j->t, lo, hi, &bad);
+        if (f) {
+            pthread_mutex_lock(&j->mu);
+            if (j->fails == 0 || bad < j->first_bad) j->first_bad = bad;
+            j->fails += f;
+            pthread_mutex_unlock(&j->mu);
+        }
+    }
+    return NULL;
+}
+
+static int run(const test_t *t, int nthreads)
+{
+    job_t j = { .t = t, .next = 0, .fails = 0, .first_bad = 0 };
+    pthread_mutex_init(&j.mu, NULL);
+    pthread_t th[256];
+    struct timespec a, b;
+
+    clock_gettime(CLOCK_MONOTONIC, &a);
+    for (int i = 0; i < nthreads; i++) pthread_create(&th[i], NULL, worker, &j);
+    for (int i = 0; i < nthreads; i++) pthread_join(th[i], NULL);
+    clock_gettime(CLOCK_MONOTONIC, &b);
+
+    double s = (b.tv_sec - a.tv_sec) + 1e-9 * (b.tv_nsec - a.tv_nsec);
+    uint64_t cases = (t->n + t->stride - 1) / t->stride;
+    printf("%-34s %14llu cases %8.2f s  %s", t->name, (unsigned long long)cases, s,
+           j.fails ? "FAIL" : "ok");
+    if (j.fails) printf("  (%llu bad, first index %llu)", (unsigned long long)j.fails,
+                        (unsigned long long)j.first_bad);
+    printf("\n");
+    pthread_mutex_destroy(&j.mu);
+    return j.fails != 0;
+}
+
+// first index in [lo, hi) that is a multiple of stride
+static inline uint64_t first_idx(const test_t *t, uint64_t lo)
+{
+    return (lo + t->stride - 1) / t->stride * t->stride;
+}
+
+#define FAIL_AT(i) do { if (!fails++) *bad = (i); } while (0)
+
+// ---------- 1) exhaustive ----------
+// sat32_bl == sat32_ref for x in [-2^32, 2^32)
+static uint64_t ex_sat32(const test_t *t, uint64_t lo, uint64_t hi, uint64_t *bad)
+{
+    uint64_t fails = 0;
+    for (uint64_t i = first_idx(t, lo); i < hi; i += t->stride) {
+        int64_t x = (int64_t)i - (1ll << 32);
+        if (pll_sat32_bl(x) != pll_sat32_ref(x)) FAIL_AT(i);
+    }
+    return fails;
+}
+
+// add_sat32 == sat32_ref(a + b) for a, b with arbitrary high halves
+static uint64_t ex_add_sat32(const test_t *t, uint64_t lo, uint64_t hi, uint64_t *bad)
+{
+    uint64_t fails = 0;
+    for (uint64_t i = first_idx(t, lo); i < hi; i += t->stride) {
+        int32_t a = (int32_t)((uint32_t)(i >> 16) << 16) | 0x7FFF;
+        int32_t b = (int32_t)((uint32_t)i << 16) | (int32_t)(i & 0x8001);
+        if (pll_add_sat32(a, b) != pll_sat32_ref((int64_t)a + b)) FAIL_AT(i);
+    }
+    return fails;
+}
+
+// mul_q30_mulh == mul_q30_ref for a = k<<16 | k', b = m<<16 | m' (all k, m)
+static uint64_t ex_mul_q30(const test_t *t, uint64_t lo, uint64_t hi, uint64_t *bad)
+{
+    uint64_t fails = 0;
+    for (uint64_t i = first_idx(t, lo); i < hi; i += t->stride) {
+        uint32_t k = (uint32_t)(i >> 16) & 0xFFFF, m = (uint32_t)i & 0xFFFF;
+        int32_t a = (int32_t)((k << 16) | (m ^ 0x5A5A));
+        int32_t b = (int32_t)((m << 16) | (k ^ 0xC3C3));
+        if (pll_mul_q30_mulh(a, b) != pll_mul_q30_ref(a, b)) FAIL_AT(i);
+        if (pll_mul_q30_mulh((int32_t)(k << 16), (int32_t)(m << 16)) !=
+            pll_mul_q30_ref((int32_t)(k << 16), (int32_t)(m << 16))) FAIL_AT(i);
+    }
+    return fails;
+}
+
+// Q15 lane ops against exact integer math, all int16 pairs
+static uint64_t ex_q15(const test_t *t, uint64_t lo, uint64_t hi, uint64_t *bad)
+{
+    uint64_t fails = 0;
+    for (uint64_t i = first_idx(t, lo); i < hi; i += t->stride) {
+        int16_t a = (int16_t)(i >> 16), b = (int16_t)i;
+        int32_t p = ((int32_t)a * b) >> 15;
+        int32_t e = (p > 32767) ? 32767 : p;
+        int32_t n = (-e < -32768) ? -32768 : ((-e > 32767) ? 32767 : -e);
+        if (pll_mul_q15(a, b) != e || pll_neg_q15(pll_mul_q15(a, b)) != n) FAIL_AT(i);
+    }
+    return fails;
+}
+
+#if defined(__SSE2__)
+// SSE2 8-lane kernel == scalar, all int16 pairs (8 pairs per call)
+static uint64_t ex_q15_sse2(const test_t *t, uint64_t lo, uint64_t hi, uint64_t *bad)
+{
+    uint64_t fails = 0;
+    const uint64_t step = 8 * t->stride;
+    for (uint64_t i = first_idx(t, lo) & ~7ull; i < hi; i += step) {
+        int16_t xa[8], sa[8], qa[8];
+        for (int l = 0; l < 8; l++) {
+            uint64_t c = i + (uint64_t)l * t->stride;
+            xa[l] = (int16_t)(c >> 16);
+            sa[l] = (int16_t)c;
+        }
+        __m128i q = pll_negmul_q15_x8(_mm_loadu_si128((const __m128i*)xa),
+                                      _mm_loadu_si128((const __m128i*)sa));
+        _mm_storeu_si128((__m128i*)qa, q);
+        for (int l = 0; l < 8; l++)
+            if (qa[l] != pll_neg_q15(pll_mul_q15(xa[l], sa[l]))) FAIL_AT(i + (uint64_t)l * t->stride);
+    }
+    return fails;
+}
+#endif
+
+// theta wrap == floor-mod 2^30, every theta in [0, 2^30), 6 increments
+static const int32_t theta_incs[6] = { 1, -1, 1342177, -1342177, 1 << 29, -(1 << 29) };
+
+static uint64_t ex_theta(const test_t *t, uint64_t lo, uint64_t hi, uint64_t *bad)
+{
+    uint64_t fails = 0;
+    for (uint64_t i = first_idx(t, lo); i < hi; i += t->stride) {
+        uint32_t th  = (uint32_t)(i & 0x3FFFFFFF);
+        int32_t  inc = theta_incs[i >> 30];
+        int64_t  r   = ((int64_t)th + inc) % (1ll << 30);
+        if (r < 0) r += 1ll << 30;
+        if (pll_theta_add_q30(th, inc) != (uint32_t)r) FAIL_AT(i);
+    }
+    return fails;
+}
+
+// quarter-wave NCO == full table, every theta index and both outputs
+static uint64_t ex_nco(const test_t *t, uint64_t lo, uint64_t hi, uint64_t *bad)
+{
+    uint64_t fails = 0;
+    for (uint64_t i = first_idx(t, lo); i < hi; i += t->stride) {
+        uint32_t th = (uint32_t)i << 10;       // every 10-bit index, varying low bits
+        int32_t s0, c0, s1, c1;
+        pll_nco_lut_q30(th | (uint32_t)(i & 0x3FF), &s0, &c0);
+        pll_nco_quarter_q30(th | (uint32_t)(i & 0x3FF), &s1, &c1);
+        if (s0 != s1 || c0 != c1) FAIL_AT(i);
+    }
+    return fails;
+}
+
+// ---------- 2) random over the full domain ----------
+static inline uint64_t splitmix(uint64_t *s)
+{
+    uint64_t z = (*s += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static uint64_t rnd_props(const test_t *t, uint64_t lo, uint64_t hi, uint64_t *bad)
+{
+    (void)t;
+    uint64_t fails = 0, s = lo * 0x2545F4914F6CDD1Dull + 1;
+    for (uint64_t i = lo; i < hi; i++) {
+        uint64_t r = splitmix(&s);
+        int32_t a = (int32_t)r, b = (int32_t)(r >> 32);
+        int64_t x = (int64_t)splitmix(&s) >> (r & 63);     // all magnitudes
+
+        if (pll_sat32_bl(x) != pll_sat32_ref(x)) FAIL_AT(i);
+        if (pll_sat32_ref(pll_sat32_ref(x)) != pll_sat32_ref(x)) FAIL_AT(i);
+        if (pll_mul_q30_mulh(a, b) != pll_mul_q30_ref(a, b)) FAIL_AT(i);
+        if (pll_mul_q30_ref(a, b) != pll_mul_q30_ref(b, a)) FAIL_AT(i);
+        if (pll_mul_q30_ref(a, 1 << 30) != a) FAIL_AT(i);            // x * 1.0 == x
+        if (pll_add_sat32(a, b) != pll_sat32_ref((int64_t)a + b)) FAIL_AT(i);
+        if (pll_theta_add_q30((uint32_t)a, b) != (((uint32_t)a + (uint32_t)b) & 0x3FFFFFFFu)) FAIL_AT(i);
+    }
+    return fails;
+}
+
+// ---------- 3) differential: pll_q30_step vs reference ----------
+static uint64_t diff_step(const test_t *t, uint64_t lo, uint64_t hi, uint64_t *bad)
+{
+    (void)t;
+    uint64_t fails = 0;
+    for (uint64_t i = lo; i < hi; i++) {
+        uint64_t s = i * 0x9E3779B97F4A7C15ull + 7;
+        pll_q30_state_t a, b;
+        uint64_t r = splitmix(&s);
+        // gains over their full range every 4th stream, realistic otherwise
+        int32_t kp = (i & 3) ? (int32_t)(r & 0x3FFFFFFF) : (int32_t)r;
+        int32_t ki = (i & 3) ? (int32_t)((r >> 32) & 0x00FFFFFF) : (int32_t)(r >> 32);
+        pll_q30_init(&a, kp, ki);
+        pll_q30_init(&b, kp, ki);
+        a.integrator_q30 = b.integrator_q30 = (int32_t)splitmix(&s);
+        a.theta_q30 = b.theta_q30 = (uint32_t)splitmix(&s) & 0x3FFFFFFF;
+
+        uint32_t amp_sh = (uint32_t)(r >> 58);              // 0..63: input scale
+        for (int n = 0; n < STEP_LEN; n++) {
+            int32_t x = (int32_t)splitmix(&s) >> (amp_sh % 9 + 8);   // |x| <= 2^23
+            pll_q30_step(&a, x);
+            pll_q30_ref_step(&b, x);
+            if (a.sin_q30 != b.sin_q30 || a.out_f_q25 != b.out_f_q25 ||
+                a.theta_q30 != b.theta_q30 || a.integrator_q30 != b.integrator_q30
+#if PLL_OUT_COS
+                || a.cos_q30 != b.cos_q30
+#endif
+#if PLL_OUT_DELTA
+                || a.delta_f_q25 != b.delta_f_q25
+#endif
+                ) { FAIL_AT(i); break; }
+        }
+    }
+    return fails;
+}
+
+// pll_q30w (64-bit PI) vs reference: bit-exact up to the first sample on
+// which any reference clamp engages (pll_q30w has no product or integrator
+// clamp and freezes the integrator on output saturation instead). Most
+// streams never saturate; the ones that start near the rails run into
+// saturation part way through, and large gains into the product clamps.
+#define Q30W_DIVERGE (PLL_REF_SAT_PROD | PLL_REF_SAT_SUM)
+
+static uint64_t diff_q30w(const test_t *t, uint64_t lo, uint64_t hi, uint64_t *bad)
+{
+    (void)t;
+    uint64_t fails = 0;
+    for (uint64_t i = lo; i < hi; i++) {
+        uint64_t s = i * 0xA0761D6478BD642Full + 11;
+        uint64_t r = splitmix(&s);
+        int32_t kp = (int32_t)(r & 0x3FFFFFFF) >> (r >> 60);
+        int32_t ki = (int32_t)((r >> 32) & 0x00FFFFFF);
+        pll_q30w_state_t w;
+        pll_q30_state_t  b;
+        pll_q30w_init(&w, kp, ki);
+        pll_q30_init(&b, kp, ki);
+        b.integrator_q30 = (int32_t)splitmix(&s) >> (i & 1);        // half start near the rails
+        w.integrator_q30 = b.integrator_q30;
+        w.theta_q30 = b.theta_q30 = (uint32_t)splitmix(&s) & 0x3FFFFFFF;
+
+        uint32_t amp_sh = (uint32_t)(r >> 58);
+        for (int n = 0; n < STEP_LEN; n++) {
+            int32_t x = (int32_t)splitmix(&s) >> (amp_sh % 9 + 8);    // |x| <= 2^23
+            pll_q30w_step(&w, x);
+            if (pll_q30_ref_step(&b, x) & Q30W_DIVERGE) break;
+            if (w.sin_q30 != b.sin_q30 || w.out_f_q25 != b.out_f_q25 ||
+                w.theta_q30 != b.theta_q30 || w.integrator_q30 != b.integrator_q30
+#if PLL_OUT_COS
+                || w.cos_q30 != b.cos_q30
+#endif
+#if PLL_OUT_DELTA
+                || w.delta_f_q25 != b.delta_f_q25
+#endif
+                ) { FAIL_AT(i); break; }
+        }
+    }
+    return fails;
+}
+
+// Out-of-range excursion and back: 5 s at 50 Hz, 10 s at the case's
+// frequency (outside the +-2 Hz the PI output can reach, so the output sits
+// on its clamp), 10 s at 50 Hz. pll_q30 and pll_q30w must both re-lock
+// (out_f within RELOCK_HZ of 50 Hz from then to the end) within
+// RELOCK_MAX_S; an integrator that wound up would hold out_f on the rail
+// instead. pll_q30 takes 0.7..3.1 s depending on where its clamped
+// integrator is left, pll_q30w (conditional integration) about 2.8 s.
+#define RELOCK_HZ      0.5          // above the 2f ripple of the multiplier detector
+#define RELOCK_MAX_S   3.5
+static const int32_t relock_mhz[] = { 53000, 47000, 55000, 45000, 52500, 47500 };
+
+static long relock_time(int wide, int32_t f_mhz)
+{
+    const long seg = 5L * PLL_FS_HZ;
+    const int32_t tol_q25 = (int32_t)(RELOCK_HZ * (1 << 25));
+    pll_q30_state_t  q;
+    pll_q30w_state_t w;
+    pll_q30_init(&q, 0x20000000, 0x00147AE1);
+    pll_q30w_init(&w, 0x20000000, 0x00147AE1);
+    uint32_t ph = 0;
+    long locked = -1;
+    for (long n = 0; n < 5 * seg; n++) {
+        uint32_t mhz = (n >= seg && n < 3 * seg) ? (uint32_t)f_mhz : 50000u;
+        int32_t x = sine_q230[ph >> 22] >> 8;
+        ph += (uint32_t)(((uint64_t)mhz << 32) / (1000u * PLL_FS_HZ));
+        int32_t f;
+        if (wide) { pll_q30w_step(&w, x); f = w.out_f_q25; }
+        else      { pll_q30_step(&q, x);  f = q.out_f_q25; }
+        if (n < 3 * seg) continue;
+        int32_t d = f - (50 << 25);
+        if (d > tol_q25 || d < -tol_q25) locked = -1;
+        else if (locked < 0) locked = n - 3 * seg;
+    }
+    return locked;
+}
+
+static uint64_t relock_q30w(const test_t *t, uint64_t lo, uint64_t hi, uint64_t *bad)
+{
+    (void)t;
+    uint64_t fails = 0;
+    for (uint64_t i = lo; i < hi; i++) {
+        long tq = relock_time(0, relock_mhz[i]), tw = relock_time(1, relock_mhz[i]);
+        long lim = (long)(RELOCK_MAX_S * PLL_FS_HZ);
+        if (tq < 0 || tw < 0 || tq > lim || tw > lim) FAIL_AT(i);
+    }
+    return fails;
+}
+
+// Q15 bank kernel (RVP/SSE2/scalar, as built) vs pll_q15_step
+static uint64_t diff_q15_bank(const test_t *t, uint64_t lo, uint64_t hi, uint64_t *bad)
+{
+    (void)t;
+    uint64_t fails = 0;
+    for (uint64_t i = lo; i < hi; i++) {
+        uint64_t s = i * 0xD1B54A32D192ED03ull + 3;
+        uint64_t r = splitmix(&s);
+        int32_t kp = (int32_t)(r & 0x3FFFFFFF), ki = (int32_t)((r >> 32) & 0x0FFFFFFF);
+        pll_q15_bank_t bank;
+        pll_q15_state_t ref[PLL_Q15_BANK_N];
+        int16_t x[PLL_Q15_BANK_N];
+
+        pll_q15_bank_init(&bank, kp, ki);
+        for (int c = 0; c < PLL_Q15_BANK_N; c++) {
+            pll_q15_init(&ref[c], kp, ki);
+            bank.theta_q30[c] = ref[c].theta_q30 = (uint32_t)splitmix(&s) & 0x3FFFFFFF;
+        }
+        for (int n = 0; n < STEP_LEN / 4; n++) {
+            for (int c = 0; c < PLL_Q15_BANK_N; c++) {
+                x[c] = (int16_t)splitmix(&s);
+                pll_q15_step(&ref[c], x[c]);
+            }
+            pll_q15_bank_step(&bank, x);
+            for (int c = 0; c < PLL_Q15_BANK_N; c++)
+                if (bank.out_f_q25[c] != ref[c].out_f_q25 || bank.theta_q30[c] != ref[c].theta_q30 ||
+                    bank.integrator_q30[c] != ref[c].integrator_q30) { FAIL_AT(i); n = STEP_LEN; break; }
+        }
+    }
+    return fails;
+}
+
+int main(int argc, char **argv)
+{
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    int nthreads = (argc > 1) ? atoi(argv[1]) : (int)(ncpu > 0 ? ncpu : 1);
+    int quick = (argc > 2) && strcmp(argv[2], "quick") == 0;
+    uint64_t stride = quick ? 256 : 1;
+    if (nthreads < 1) nthreads = 1;
+    if (nthreads > 256) nthreads = 256;
+
+    const test_t tests[] = {
+        { "exhaustive sat32_bl",            1ull << 33, stride, ex_sat32 },
+        { "exhaustive add_sat32",           1ull << 32, stride, ex_add_sat32 },
+        { "exhaustive mul_q30_mulh",        1ull << 32, stride, ex_mul_q30 },
+        { "exhaustive mul_q15/neg_q15",     1ull << 32, stride, ex_q15 },
+#if defined(__SSE2__)
+        { "exhaustive q15 SSE2 lanes",      1ull << 32, stride, ex_q15_sse2 },
+#endif
+        { "exhaustive theta wrap",          6ull << 30, stride, ex_theta },
+        { "exhaustive quarter-wave NCO",    1ull << 20, 1,      ex_nco },
+        { "random full-domain properties",  RANDOM_CASES >> (quick ? 6 : 0), 1, rnd_props },
+        { "diff pll_q30_step vs reference", STEP_STREAMS >> (quick ? 4 : 0), 1, diff_step },
+        { "diff pll_q30w vs unsaturated ref", STEP_STREAMS >> (quick ? 4 : 0), 1, diff_q30w },
+        { "q30w re-lock after excursion",   sizeof relock_mhz / sizeof relock_mhz[0], 1, relock_q30w },
+        { "diff q15 bank vs pll_q15_step",  STEP_STREAMS >> (quick ? 4 : 0), 1, diff_q15_bank },
+    };
+
+    printf("threads=%d mode=%s  config: branchless=%d mulh=%d nco_quarter=%d out_cos=%d out_delta=%d\n",
+           nthreads, quick ? "quick" : "full", PLL_FIXED_BRANCHLESS, PLL_FIXED_MULH,
+           PLL_NCO_QUARTER, PLL_OUT_COS, PLL_OUT_DELTA);
+
+    int failed = 0;
+    for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) failed += run(&tests[i], nthreads);
+    printf("%s\n", failed ? "FAILED" : "all passed");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,163 @@
+// Independent frequency estimate (pll_sdft.h) against the input and the loop.
+//
+// Three-phase input (0.9 pu, 5 % 5th and 3 % 7th harmonic, optional noise),
+// with -r a +0.3 Hz step and a -0.5 Hz/s ramp in the second half of the
+// run. pll_q30 tracks phase a; the sliding-DFT bank sees all three phases
+// (pll_sdft_step_st, so it also averages the loop's out_f_q25 over each
+// window). Reported over the second half of the run (the loop settles in
+// several seconds at these gains):
+//   sdft : estimate (phase a) minus the mean input frequency over the DFT
+//          window, every 100 samples
+//   inst : instantaneous out_f_q25 minus the input frequency (2f ripple)
+//   loop : window mean of out_f_q25 minus the mean input frequency, and
+//   diff : window mean of out_f_q25 minus the estimate, once per window;
+//          the flags pll_sdft_check() raises at -t tol_hz
+// After -x t_s the loop integrator is corrupted by +2 Hz once (a stand-in
+// for a loop fault); the first flag after it is reported as the detection
+// latency.
+//
+// Build: cc -O2 -I.. -o freq_check freq_check.c ../pll_sdft.c ../pll_ref.c ../pll_q30.c -lm
+// Run  : ./freq_check [-f f0_hz] [-n noise_pu] [-t tol_hz] [-x fault_s] [-s seconds] [-r]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "pll_config.h"
+#include "pll_q30.h"
+#include "pll_sdft.h"
+
+#define KP_Q30     0x20000000
+#define KI_Q30     0x00147AE1
+#define Q22        4194304.0
+#define Q25        33554432.0
+#define AMP        0.9
+#define EVERY      100
+
+typedef struct { double s, s2, mx; long n; } acc_t;
+
+static void acc_add(acc_t *a, double v)
+{
+    a->s += v;
+    a->s2 += v * v;
+    if (fabs(v) > a->mx) a->mx = fabs(v);
+    a->n++;
+}
+
+static void acc_print(const char *name, const acc_t *a)
+{
+    double n = a->n ? (double)a->n : 1.0;
+    printf("  %-5s mean %+9.3f  rms %8.3f  max %8.3f mHz  (%ld points)\n", name,
+           1e3 * a->s / n, 1e3 * sqrt(a->s2 / n), 1e3 * a->mx, a->n);
+}
+
+// input frequency at time t (t0: start of the second half): f0 or the -r profile
+static double f_at(double f0, int profile, double t)
+{
+    double f = f0;
+    if (!profile) return f;
+    if (t >= 1.0) f += 0.3;
+    if (t >= 3.0) f -= 0.5 * (t < 4.0 ? t - 3.0 : 1.0);
+    return f;
+}
+
+int main(int argc, char **argv)
+{
+    double f0 = 50.0, noise = 0.0, tol = 0.1, fault_s = -1.0;
+    int    seconds = 20, profile = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if      (!strcmp(argv[i], "-f") && i + 1 < argc) f0 = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc) noise = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc) tol = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-x") && i + 1 < argc) fault_s = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) seconds = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-r")) profile = 1;
+        else {
+            fprintf(stderr, "usage: %s [-f f0_hz] [-n noise_pu] [-t tol_hz] [-x fault_s] [-s seconds] [-r]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (seconds < 10) seconds = 10;
+
+    static pll_sdft_t bank;
+    pll_q30_state_t st;
+    pll_q30_init(&st, KP_Q30, KI_Q30);
+    if (pll_sdft_init(&bank, PLL_SDFT_K_LO) != 0) { fprintf(stderr, "bad PLL_SDFT_K_LO\n"); return 1; }
+
+    const double fs = PLL_FS_HZ;
+    const long   n = (long)seconds * PLL_FS_HZ, settled = n / 2, fault_at = fault_s >= 0.0 ? lrint(fault_s * fs) : -1;
+    double *f_hist = malloc(PLL_SDFT_M * sizeof *f_hist), f_win = 0.0;
+    if (!f_hist) return 1;
+    for (uint32_t i = 0; i < PLL_SDFT_M; i++) f_hist[i] = 0.0;
+
+    acc_t e_sdft = {0}, e_inst = {0}, e_loop = {0}, e_diff = {0};
+    long  flags = 0, checks = 0, none = 0, detect = -1;
+    double ph = 0.0;
+    uint32_t seed = 1;
+    const int32_t tol_q25 = (int32_t)lrint(tol * Q25);
+
+    for (long k = 0; k < n; k++) {
+        double f = f_at(f0, profile, (double)(k - settled) / fs);
+        int32_t x[PLL_SDFT_CH];
+        for (uint32_t p = 0; p < PLL_SDFT_CH; p++) {
+            double w = 2.0 * M_PI * (ph - p / 3.0), v = AMP * sin(w) + 0.05 * sin(5 * w) + 0.03 * sin(7 * w);
+            if (noise > 0.0) {
+                seed = seed * 1664525u + 1013904223u;
+                v += noise * ((double)seed / 4294967296.0 - 0.5) * sqrt(12.0);
+            }
+            x[p] = (int32_t)lrint(v * Q22);
+        }
+        ph += f / fs;
+        ph -= floor(ph);
+
+        if (k == fault_at) st.integrator_q30 += (int32_t)lrint(2.0 * Q25) << PLL_DF_SHIFT;
+        pll_q30_step(&st, x[0]);
+        int block = pll_sdft_step_st(&bank, &st, x);
+
+        // mean frequency over the DFT window (what the estimate should see)
+        uint32_t slot = (uint32_t)k & (PLL_SDFT_M - 1u);
+        f_win += f - f_hist[slot];
+        f_hist[slot] = f;
+
+        if (k < settled) continue;
+        int pre = fault_at < 0 || k < fault_at;
+        if (k % EVERY == 0 && pre) {
+            int32_t fe;
+            if (pll_sdft_freq(&bank, 0, &fe) == 0) acc_add(&e_sdft, fe / Q25 - f_win / PLL_SDFT_M);
+            else none++;
+            acc_add(&e_inst, st.out_f_q25 / Q25 - f);
+        }
+        if (!block) continue;
+        int32_t fe;
+        int fl = pll_sdft_check(&bank, 0, tol_q25);
+        if (pre && pll_sdft_freq(&bank, 0, &fe) == 0) {
+            acc_add(&e_loop, bank.loop_f_q25 / Q25 - f_win / PLL_SDFT_M);
+            acc_add(&e_diff, (bank.loop_f_q25 - fe) / Q25);
+        }
+        checks++;
+        if (fl == 1 && pre) flags++;
+        if (fl == 1 && !pre && detect < 0) detect = k - fault_at;
+    }
+
+    printf("input %.3f Hz%s, noise %.3f pu, Fs %d Hz, %d s\n", f0,
+           profile ? " (+0.3 Hz step at +1 s, -0.5 Hz/s ramp +3..+4 s)" : "", noise, PLL_FS_HZ, seconds);
+    printf("  settled window from %.1f s\n", settled / fs);
+    printf("  bank: M %u (%.1f ms), bins %u..%u at %.3f Hz, %u channels\n", PLL_SDFT_M, 1e3 * PLL_SDFT_M / fs,
+           PLL_SDFT_K_LO, PLL_SDFT_K_LO + PLL_SDFT_NB - 1, fs / PLL_SDFT_M, PLL_SDFT_CH);
+    acc_print("sdft", &e_sdft);
+    acc_print("inst", &e_inst);
+    acc_print("loop", &e_loop);
+    acc_print("diff", &e_diff);
+    printf("  flags at %.3f Hz before the fault: %ld of %ld checks", tol, flags, checks);
+    if (none) printf(" (%ld without an estimate)", none);
+    printf("\n");
+    if (fault_at >= 0) {
+        if (detect >= 0) printf("  fault at %.2f s detected after %.1f ms\n", fault_s, 1e3 * detect / fs);
+        else             printf("  fault at %.2f s not detected\n", fault_s);
+    }
+    free(f_hist);
+    return 0;
+}
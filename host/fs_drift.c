@@ -0,0 +1,82 @@
+// Sample-clock drift against a PPS reference: pll_q30 with and without the
+// pll_pps.h estimator.
+//
+// The ADC runs at Fs * (1 + ppm * 1e-6) while the loop assumes PLL_FS_HZ; the
+// input is an exact F0 sine in reference time. Untrimmed, out_f reads
+// F0 / (1 + ppm * 1e-6), i.e. low by about F0 * ppm * 1e-6. With the estimator, a PPS edge every second (sample counter
+// = first sample at or after the edge) trims inv_fs_q40 in the state. Prints
+// the 1 s mean of out_f - F0 for both, the estimated ppm and the applied
+// reciprocal.
+//
+// Build: cc -O2 -I.. -o fs_drift fs_drift.c ../pll_q30.c ../pll_pps.c -lm
+// Run  : ./fs_drift [-p ppm] [-s seconds] [-f f0_hz]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "pll_config.h"
+#include "pll_q30.h"
+#include "pll_pps.h"
+
+#if !PLL_FS_TRIM
+#error "build with PLL_FS_TRIM=1 (the default)"
+#endif
+
+#define KP_Q30     0x20000000
+#define KI_Q30     0x00147AE1
+#define AMP        0.9
+
+int main(int argc, char **argv)
+{
+    double ppm = 50.0, f0 = 50.0;
+    int    seconds = 60;
+
+    for (int i = 1; i < argc; i++) {
+        if      (!strcmp(argv[i], "-p") && i + 1 < argc) ppm = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) seconds = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-f") && i + 1 < argc) f0 = atof(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [-p ppm] [-s seconds] [-f f0_hz]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (seconds < 2) seconds = 2;
+
+    const double fs_true = PLL_FS_HZ * (1.0 + ppm * 1e-6);
+    pll_q30_state_t plain, trim;
+    pll_pps_t pps;
+    pll_q30_init(&plain, KP_Q30, KI_Q30);
+    pll_q30_init(&trim, KP_Q30, KI_Q30);
+    pll_pps_init(&pps, PLL_FS_HZ);
+
+    printf("ADC at %.4f Hz (%+.2f ppm), input %.3f Hz, expected untrimmed error %+.6f Hz\n",
+           fs_true, ppm, f0, -f0 * ppm * 1e-6 / (1.0 + ppm * 1e-6));
+    printf("%5s %14s %14s %12s %12s\n", "t [s]", "plain [Hz]", "trimmed [Hz]", "est. ppm", "inv_fs_q40");
+
+    uint64_t n = 0;
+    for (int sec = 0; sec < seconds; sec++) {
+        // PPS edge at t = sec: first sample at or after it
+        uint64_t n_end = (uint64_t)ceil((sec + 1) * fs_true);
+        double   sa = 0.0, sb = 0.0;
+        uint64_t cnt = n_end - n;
+        for (; n < n_end; n++) {
+            double t = n / fs_true;
+            int32_t x = (int32_t)lrint(AMP * sin(2.0 * M_PI * f0 * t) * (1 << 22));
+            pll_q30_step(&plain, x);
+            pll_q30_step(&trim, x);
+            sa += plain.out_f_q25 / 33554432.0;
+            sb += trim.out_f_q25 / 33554432.0;
+        }
+        pll_pps_edge(&pps, n_end, (uint64_t)(sec + 1) << 32);
+        pll_pps_apply(&pps, &trim);
+        if (sec < 5 || (sec + 1) % 5 == 0)
+            printf("%5d %+14.6f %+14.6f %+12.3f %12u\n", sec + 1, sa / cnt - f0, sb / cnt - f0,
+                   pps.ppb / 1000.0, (unsigned)trim.inv_fs_q40);
+    }
+    printf("nominal inv_fs_q40 %u, ideal for the true rate %.1f\n", (unsigned)PLL_INV_FS_Q40,
+           1099511627776.0 / fs_true);
+    return 0;
+}
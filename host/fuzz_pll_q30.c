@@ -0,0 +1,596 @@
+// Coverage-guided fuzz harness for pll_q30_step, the block API and state
+// save/restore, plus the optimized variants they are built from.
+//
+// Input: [kp][ki][integrator][theta][split][flip] header (4 x int32, 2 x u16,
+// little endian) followed by int32 Q22 samples. Every value is used as is, so
+// the fuzzer reaches saturated gains, full-scale inputs and INT32_MIN.
+//
+// Invariants (abort on violation, so the fuzzer records a crash):
+//  - pll_q30_step (as built) == pll_q30_ref_step, every sample, every field
+//  - pll_q30_step_block == repeated pll_q30_step, per-sample out_f included
+//  - pll_q30_step_dt(PLL_INV_FS_Q32) == pll_q30_step; pll_q30_step_block_ts ==
+//    repeated pll_q30_step_dt, with sample words reused as arbitrary dt
+//  - a trimmed inv_fs_q40 (PLL_FS_TRIM) == step_dt with the same reciprocal
+//  - pll_phase: extrapolating one sample back from a snapshot gives the
+//    previous theta exactly; publish/read round-trips the snapshot
+//  - pll_zc: time to a target phase == dphi / inc by 64-bit division, after
+//    init and after one incremental update to a nearby rate
+//  - pll_ref_eval (scalar or AVX2) == pll_nco_interp_q30(theta + offset),
+//    sample words as offsets
+//  - pll_ipark: block == per-sample; unsaturated a + b + c == 0 and, with
+//    min-max injection, max + min == 0 (to rounding); the fused step block
+//    == pll_q30_step + pll_ipark_step (PLL_OUT_COS)
+//  - pll_pwr: any input words (UBSan), cycle averages only at a theta wrap
+//  - pll_rs: interpolation kernel (scalar or SSE4.1) == cubic Lagrange in
+//    64-bit arithmetic; push with arbitrary samples and phases keeps the
+//    queue consistent, blocks in order, outputs within the Lagrange gain
+//  - pll_sdft: the sliding sums == the direct DFT of the window (64-bit,
+//    exact), samples fed twice so the window wraps (M <= 2 n: build with
+//    -DPLL_SDFT_LOG2M=8 -DPLL_SDFT_F_NOM_HZ=1000 for short inputs); estimates
+//    stay in the bank's range
+//  - pll_bq: bank (scalar or AVX2) == pll_bq_section per channel with
+//    sample words as coefficients and inputs; pll_q30_step_lf with an empty
+//    cascade or PLL_BQ_PASS sections == pll_q30_step (PLL_LOOP_FILTER)
+//  - theta_q30 in [0, 2^30) for every engine after every step
+//  (the block, step_dt / timestamp and snapshot checks need PLL_API_BLOCK,
+//   PLL_API_TS and PLL_API_SNAPSHOT, off in PLL_PROFILE_MINIMAL)
+//  - save at sample `split`, restore into a fresh state: continues identically
+//  - any single bit flip of the snapshot is rejected and leaves *st untouched
+//  - restore of arbitrary bytes either fails or yields an in-range theta
+//  - pll_fixed fast helpers == *_ref on sample pairs as operands
+//  - Q15 bank kernel == pll_q15_step per channel; Q15 init rejects gains
+//    outside [-1, 1) (the bank runs with kp/2, ki/2)
+//  - pll_q30w == reference up to the first sample any reference clamp
+//    engages; its integrator stays within +-3 * 2^31 (conditional integration)
+// Undefined shifts and signed overflow are caught by UBSan in the builds below.
+//
+// Build (libFuzzer):
+//   clang -g -O1 -fsanitize=fuzzer,address,undefined -fno-sanitize-recover=all
+//         -DPLL_FUZZ_LIBFUZZER -I.. -o fuzz_pll_q30 fuzz_pll_q30.c
+//         ../pll_q30.c ../pll_q30w.c ../pll_q15.c ../pll_f32.c ../pll_ref.c ../pll_ipark.c ../pll_power.c ../pll_resamp.c ../pll_sdft.c ../pll_biquad.c -lm
+// Build (AFL / plain, reads stdin or files):
+//   afl-cc -O1 -fsanitize=undefined -fno-sanitize-recover=all -I.. -o fuzz_pll_q30
+//          fuzz_pll_q30.c ../pll_q30.c ../pll_q30w.c ../pll_q15.c ../pll_f32.c ../pll_ref.c ../pll_ipark.c ../pll_power.c ../pll_resamp.c ../pll_sdft.c ../pll_biquad.c -lm
+//   (cc works as well; repeat with -DPLL_FIXED_BRANCHLESS=1 -DPLL_FIXED_MULH=1,
+//    -DPLL_PROFILE_MINIMAL, -mavx2, -msse4.1, ... to cover each library configuration)
+// Run  : ./fuzz_pll_q30 corpus/            (libFuzzer)
+//        afl-fuzz -i in -o out ./fuzz_pll_q30
+//        ./fuzz_pll_q30 file...            (replay)
+//        ./fuzz_pll_q30 -r 100000          (self-contained random smoke run)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "pll_q30.h"
+#include "pll_q15.h"
+#include "pll_q30w.h"
+#include "pll_f32.h"
+#include "pll_fixed.h"
+#include "pll_q30_ref.h"
+#include "pll_phase.h"
+#include "pll_ref.h"
+#include "pll_ipark.h"
+#include "pll_power.h"
+#include "pll_resamp.h"
+#include "pll_sdft.h"
+#include "pll_biquad.h"
+#include "pll_nco.h"
+
+#define HDR_BYTES    20
+// reference clamps pll_q30w does not reproduce (pll_q30w.h)
+#define Q30W_DIVERGE (PLL_REF_SAT_PROD | PLL_REF_SAT_SUM)
+#define MAX_SAMPLES  4096
+
+#define CHECK(c) do { if (!(c)) { \
+    fprintf(stderr, "fuzz_pll_q30: %s:%d: %s\n", __FILE__, __LINE__, #c); abort(); } } while (0)
+
+static int32_t rd32(const uint8_t *p)
+{
+    uint32_t v = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    return (int32_t)v;
+}
+
+static int same_state(const pll_q30_state_t *a, const pll_q30_state_t *b)
+{
+    return a->sin_q30 == b->sin_q30 && a->out_f_q25 == b->out_f_q25 &&
+           a->theta_q30 == b->theta_q30 && a->integrator_q30 == b->integrator_q30
+#if PLL_OUT_COS
+           && a->cos_q30 == b->cos_q30
+#endif
+#if PLL_OUT_DELTA
+           && a->delta_f_q25 == b->delta_f_q25
+#endif
+           ;
+}
+
+static void check_helpers(int32_t a, int32_t b)
+{
+    int64_t x = (int64_t)a * (int64_t)b;
+    CHECK(pll_sat32_bl(x) == pll_sat32_ref(x));
+    CHECK(pll_sat32_bl((int64_t)a * 65536) == pll_sat32_ref((int64_t)a * 65536));
+    CHECK(pll_mul_q30_mulh(a, b) == pll_mul_q30_ref(a, b));
+    CHECK(pll_add_sat32(a, b) == pll_sat32_ref((int64_t)a + b));
+    CHECK(pll_theta_add_q30((uint32_t)a & 0x3FFFFFFF, b) <= 0x3FFFFFFFu);
+}
+
+#if PLL_API_SNAPSHOT
+static void check_snapshot(const pll_q30_state_t *st, unsigned flip, const uint8_t *raw, size_t raw_n)
+{
+    pll_q30_snapshot_t snap, bad;
+    pll_q30_state_t r, keep;
+
+    pll_q30_save(st, &snap);
+    memset(&r, 0xA5, sizeof r);
+    CHECK(pll_q30_restore(&r, &snap) == 0);
+    CHECK(same_state(&r, st) && r.kp_q30 == st->kp_q30 && r.ki_q30 == st->ki_q30);
+
+    // single bit flip anywhere in the image must be detected
+    bad = snap;
+    ((uint8_t *)&bad)[(flip >> 3) % sizeof bad] ^= (uint8_t)(1u << (flip & 7));
+    keep = r;
+    CHECK(pll_q30_restore(&r, &bad) == -1);
+    CHECK(memcmp(&r, &keep, sizeof r) == 0);
+
+    // arbitrary bytes: reject, or a usable state
+    if (raw_n >= sizeof bad) {
+        memcpy(&bad, raw, sizeof bad);
+        if (pll_q30_restore(&r, &bad) == 0) CHECK(r.theta_q30 <= 0x3FFFFFFFu);
+    }
+}
+#endif
+
+static void check_q15_bank(int32_t kp, int32_t ki, const int32_t *x, size_t n)
+{
+    pll_q15_bank_t bank;
+    pll_q15_state_t ref[PLL_Q15_BANK_N];
+    int16_t xb[PLL_Q15_BANK_N];
+
+    // gains outside [-1, 1) are rejected; >> 1 maps any int32 onto that range
+    int ok = kp >= -(1 << 30) && kp < (1 << 30) && ki >= -(1 << 30) && ki < (1 << 30);
+    CHECK(pll_q15_init(&ref[0], kp, ki) == (ok ? 0 : -1));
+    CHECK(pll_q15_bank_init(&bank, kp, ki) == (ok ? 0 : -1));
+    kp >>= 1;
+    ki >>= 1;
+    CHECK(pll_q15_bank_init(&bank, kp, ki) == 0);
+    for (int c = 0; c < PLL_Q15_BANK_N; c++) CHECK(pll_q15_init(&ref[c], kp, ki) == 0);
+    for (size_t i = 0; i < n; i++) {
+        for (int c = 0; c < PLL_Q15_BANK_N; c++) {
+            xb[c] = pll_q15_from_q22(x[(i + (size_t)c) % n]);
+            pll_q15_step(&ref[c], xb[c]);
+            CHECK(ref[c].theta_q30 <= 0x3FFFFFFFu);
+        }
+        pll_q15_bank_step(&bank, xb);
+        for (int c = 0; c < PLL_Q15_BANK_N; c++)
+            CHECK(bank.out_f_q25[c] == ref[c].out_f_q25 && bank.theta_q30[c] == ref[c].theta_q30 &&
+                  bank.integrator_q30[c] == ref[c].integrator_q30);
+    }
+}
+// st: just stepped from theta th_prev; sample: samples stepped so far
+static void check_phase(const pll_q30_state_t *st, uint32_t th_prev, uint32_t sample)
+{
+    pll_phase_snap_t ps, rd;
+    pll_phase_pub_t pub;
+    pll_phase_take(&ps, st, sample);
+    CHECK(pll_phase_at_q30(&ps, 0) == st->theta_q30);
+    CHECK(pll_phase_at_q30(&ps, -65536) == th_prev);
+    CHECK(pll_phase_at_sample_q30(&ps, sample - 1u, 0) == th_prev);
+    CHECK(pll_phase_at_q30(&ps, (int32_t)(th_prev | 0x80000000u)) <= 0x3FFFFFFFu);
+    pll_phase_pub_init(&pub);
+    pll_phase_publish(&pub, st, sample);
+    CHECK(pll_phase_read(&pub, &rd, 1) == 0);
+    CHECK(memcmp(&rd, &ps, sizeof rd) == 0 && (pub.seq & 1u) == 0);
+
+    pll_zc_t z;
+    if (pll_zc_init(&z, st) != 0) {
+        CHECK(ps.inc_q30 <= PLL_ZC_INC_MIN && pll_zc_time_q16(&z, th_prev, 0) == 0xFFFFFFFFu);
+        return;
+    }
+    for (int k = 0; k < 2; k++) {
+        if (k && (z.inc_q30 >= (1 << 30) || pll_zc_set_inc(&z, z.inc_q30 + (z.inc_q30 >> 12)) != 0)) break;
+        uint64_t dphi  = (th_prev - st->theta_q30) & 0x3FFFFFFFu;
+        uint64_t exact = (dphi << 16) / (uint64_t)z.inc_q30;
+        uint64_t t     = pll_zc_time_q16(&z, st->theta_q30, th_prev);
+        CHECK((t > exact ? t - exact : exact - t) <= 2u + (exact >> 20));
+    }
+}
+
+static void check_ref(uint32_t theta, const int32_t *x, size_t n)
+{
+    pll_ref_set_t set;
+    int32_t s[PLL_REF_MAX], c[PLL_REF_MAX];
+    uint32_t m = (uint32_t)(n % (PLL_REF_MAX + 1));
+    CHECK(pll_ref_init(&set, (const uint32_t *)x, m) == 0);
+    CHECK(pll_ref_init(&set, NULL, PLL_REF_MAX + 1) == -1);
+    CHECK(pll_ref_init(&set, (const uint32_t *)x, m) == 0);
+    pll_ref_eval(&set, theta, s, c);
+    for (uint32_t k = 0; k < m; k++) {
+        int32_t es, ec;
+        pll_nco_interp_q30((theta + (uint32_t)x[k]) & 0x3FFFFFFFu, &es, &ec);
+        CHECK(s[k] == es && c[k] == ec);
+    }
+}
+
+// sin/cos from the samples (arbitrary, not on the unit circle), id/iq from
+// the following words
+static void check_ipark(const pll_q30_state_t *st0, const int32_t *x, size_t n)
+{
+    enum { M = 64 };
+    int32_t a[M], b[M], c[M], abc[3 * M];
+    size_t m = n / 4 < M ? n / 4 : M;
+    const int32_t *s = x, *co = x + m, *id = x + 2 * m, *iq = x + 3 * m;
+    for (unsigned flags = 0; flags <= PLL_IPARK_ZSI; flags++) {
+        pll_ipark_block(s, co, id, iq, flags, a, b, c, m);
+        for (size_t i = 0; i < m; i++) {
+            int32_t r[3];
+            pll_ipark_abc(s[i], co[i], id[i], iq[i], flags, r);
+            CHECK(r[0] == a[i] && r[1] == b[i] && r[2] == c[i]);
+            int sat = 0;
+            for (int k = 0; k < 3; k++) sat |= r[k] == INT32_MAX || r[k] == INT32_MIN;
+            if (sat) continue;
+            int64_t mx = r[0], mn = r[0], sum = (int64_t)r[0] + r[1] + r[2];
+            for (int k = 1; k < 3; k++) { mx = r[k] > mx ? r[k] : mx; mn = r[k] < mn ? r[k] : mn; }
+            if (flags) CHECK(mx + mn >= -1 && mx + mn <= 1);
+            else       CHECK(sum >= -2 && sum <= 2);
+        }
+    }
+#if PLL_OUT_COS
+    pll_q30_state_t p = *st0, q = *st0;
+    pll_ipark_step_block(&p, x, id, iq, PLL_IPARK_ZSI, abc, m);
+    for (size_t i = 0; i < m; i++) {
+        int32_t r[3];
+        pll_q30_step(&q, x[i]);
+        pll_ipark_step(&q, id[i], iq[i], PLL_IPARK_ZSI, r);
+        CHECK(memcmp(r, &abc[3 * i], sizeof r) == 0);
+    }
+    CHECK(same_state(&p, &q));
+#else
+    (void)st0;
+    (void)abc;
+#endif
+}
+
+// sample words as v, i, sin/cos and theta, 7 * PLL_PWR_N words per step
+static void check_power(const int32_t *x, size_t n)
+{
+    static pll_pwr_bank_t bank;
+    const size_t w = 7 * PLL_PWR_N;
+    pll_pwr_init(&bank, PLL_PWR_AVG | PLL_PWR_DQ);
+    uint32_t prev = 0;
+    for (size_t j = 0; j + w <= n; j += w) {
+        const int32_t (*v)[PLL_PWR_N] = (const int32_t (*)[PLL_PWR_N])&x[j];
+        const int32_t (*i)[PLL_PWR_N] = (const int32_t (*)[PLL_PWR_N])&x[j + 3 * PLL_PWR_N];
+        uint32_t theta = (uint32_t)x[j + 6 * PLL_PWR_N] & 0x3FFFFFFFu;
+        uint32_t cycles = bank.cycles;
+        int done = pll_pwr_step(&bank, theta, x[j + 6 * PLL_PWR_N + 1], x[j + 6 * PLL_PWR_N + 2], v, i);
+        CHECK(bank.cycles == cycles + (uint32_t)done);
+        if (done) CHECK(theta < prev);
+        prev = theta;
+    }
+}
+
+// Lagrange coefficients in 64-bit, truncated the same way as the kernel
+static int32_t rs_ref(const int32_t *x, int64_t u)
+{
+    const int64_t one = 1 << 30;
+    int64_t w = (u >> 1) - one, p = (u * (u - one)) >> 30;
+    int64_t c[4] = {
+        -((((p * w) >> 30) * 357913941) >> 30),
+        (((u * u) >> 30) - one) * w >> 30,
+        -((((u * (u + one)) >> 30) * w) >> 30),
+        ((((u + one) * p) >> 30) * 178956971) >> 30,
+    };
+    int64_t acc = 0;
+    for (int t = 0; t < 4; t++) acc += c[t] * x[t - 1];
+    return (int32_t)(acc >> 30);
+}
+
+// sample words as inputs (Q22 range), positions and phases
+static void check_resamp(const int32_t *x, size_t n)
+{
+    static pll_rs_t rs;
+    static int32_t buf[64], out[64];
+    static uint32_t pos[64];
+    static int32_t u[64];
+    size_t m = n < 64 ? n : 64;
+    for (size_t k = 0; k < 64; k++) buf[k] = k < m ? x[k] : (int32_t)k;
+    for (size_t k = 0; k < m; k++) {
+        pos[k] = 1u + (uint32_t)x[k] % 60u;
+        u[k]   = (int32_t)((uint32_t)x[k] >> 2);               // [0, 2^30)
+    }
+    pll_rs_interp(buf, pos, u, out, m);
+    for (size_t k = 0; k < m; k++) CHECK(out[k] == rs_ref(buf + pos[k], u[k]));
+
+    // phase advance from the sample word: mostly locked-like steps, any rate
+    pll_rs_init(&rs);
+    uint32_t theta = 0, seen = 0, max_in = 0;
+    for (size_t i = 0; i < n; i++) {
+        int32_t xi = x[i] >> 8;
+        uint32_t ax = xi < 0 ? (uint32_t)-(int64_t)xi : (uint32_t)xi;
+        if (ax > max_in) max_in = ax;
+        uint32_t before = rs.cycle;
+        int rc = pll_rs_push(&rs, xi, theta);
+        CHECK(rs.cycle - before == (uint32_t)(rc != 0));
+        CHECK((uint32_t)(rs.head - rs.tail) <= PLL_RS_QN);
+        theta += (x[i] & 1) ? ((uint32_t)x[i] >> 2) : (1u << 30) / 300u + ((uint32_t)x[i] & 0xFFFu);
+        const pll_rs_block_t *b;
+        if ((i & 7) == 0)
+            while ((b = pll_rs_peek(&rs)) != NULL) {
+                CHECK(b->cycle > seen);
+                seen = b->cycle;
+                for (uint32_t k = 0; k < PLL_RS_N; k++) {
+                    uint32_t ay = b->x_q22[k] < 0 ? (uint32_t)-(int64_t)b->x_q22[k] : (uint32_t)b->x_q22[k];
+                    CHECK(ay <= max_in + max_in / 4 + 2);
+                }
+                pll_rs_release(&rs);
+            }
+    }
+    CHECK(rs.cycle >= rs.dropped);
+}
+
+// channels from rotated sample words; reference sums with the table twiddles
+static void check_sdft(const int32_t *x, size_t n)
+{
+    static pll_sdft_t b;
+    static int16_t h[PLL_SDFT_CH][2 * MAX_SAMPLES];
+    CHECK(pll_sdft_init(&b, PLL_SDFT_K_LO) == 0);
+    size_t total = 2 * n;
+    for (size_t i = 0; i < total; i++) {
+        int32_t in[PLL_SDFT_CH];
+        for (uint32_t ch = 0; ch < PLL_SDFT_CH; ch++) {
+            in[ch] = x[(i + ch) % n];
+            h[ch][i] = pll_sat16(in[ch] >> 8);
+        }
+        pll_sdft_step(&b, in);
+    }
+    size_t first = total > PLL_SDFT_M ? total - PLL_SDFT_M : 0;
+    for (uint32_t ch = 0; ch < PLL_SDFT_CH; ch++)
+        for (uint32_t j = 0; j < PLL_SDFT_NB; j++) {
+            int64_t re = 0, im = 0;
+            uint32_t k = PLL_SDFT_K_LO + j;
+            for (size_t m = first; m < total; m++) {
+                int32_t s, c;
+                pll_nco_interp_q30(((uint32_t)(k * m) & (PLL_SDFT_M - 1u)) << (30 - PLL_SDFT_LOG2M), &s, &c);
+                re += (int64_t)h[ch][m] * c;
+                im -= (int64_t)h[ch][m] * s;
+            }
+            CHECK(b.re[ch][j] == re && b.im[ch][j] == im);
+        }
+    int32_t f;
+    const int64_t lo = ((int64_t)PLL_SDFT_K_LO + 1) * PLL_FS_HZ * 32 * 1024 * 1024 / PLL_SDFT_M;
+    const int64_t hi = ((int64_t)PLL_SDFT_K_LO + PLL_SDFT_NB - 2) * PLL_FS_HZ * 32 * 1024 * 1024 / PLL_SDFT_M;
+    for (uint32_t ch = 0; ch < PLL_SDFT_CH; ch++)
+        if (pll_sdft_freq(&b, ch, &f) == 0) CHECK(f >= (lo < INT32_MAX ? lo : INT32_MAX) && f <= hi);
+}
+
+// coefficients from sample words, shift 0..PLL_BQ_SHIFT_MAX
+static void check_biquad(const pll_q30_state_t *st0, const int32_t *x, size_t n)
+{
+    static pll_bq_bank_t bank;
+    pll_bq_coef_t c[PLL_BQ_MAX];
+    for (uint32_t k = 0; k < PLL_BQ_MAX; k++) {
+        c[k].b0 = x[(5 * k) % n];
+        c[k].b1 = x[(5 * k + 1) % n];
+        c[k].b2 = x[(5 * k + 2) % n];
+        c[k].a1 = x[(5 * k + 3) % n];
+        c[k].a2 = x[(5 * k + 4) % n];
+        c[k].shift = (int32_t)((uint32_t)x[(5 * k + 4) % n] % (PLL_BQ_SHIFT_MAX + 1u));
+    }
+    uint32_t ns = (uint32_t)x[0] % (PLL_BQ_MAX + 1u);
+    CHECK(pll_bq_bank_init(&bank, c, ns) == 0);
+    int64_t s1[PLL_BQ_MAX][PLL_BQ_CH] = {{0}}, s2[PLL_BQ_MAX][PLL_BQ_CH] = {{0}};
+    for (size_t i = 0; i < n; i++) {
+        int32_t in[PLL_BQ_CH], out[PLL_BQ_CH];
+        for (uint32_t ch = 0; ch < PLL_BQ_CH; ch++) in[ch] = x[(i + ch) % n];
+        pll_bq_bank_run(&bank, in, out);
+        for (uint32_t ch = 0; ch < PLL_BQ_CH; ch++) {
+            int32_t v = in[ch];
+            for (uint32_t k = 0; k < ns; k++) v = pll_bq_section(&c[k], &s1[k][ch], &s2[k][ch], v);
+            CHECK(out[ch] == v);
+        }
+    }
+    c[0].shift = PLL_BQ_SHIFT_MAX + 1;
+    CHECK(pll_bq_bank_init(&bank, c, 1) == -1);
+    CHECK(pll_bq_bank_init(&bank, c, PLL_BQ_MAX + 1u) == -1);
+
+#if PLL_LOOP_FILTER
+    const pll_bq_coef_t one = PLL_BQ_PASS;
+    pll_bq_coef_t pass[PLL_BQ_MAX];
+    for (uint32_t k = 0; k < PLL_BQ_MAX; k++) pass[k] = one;
+    pll_bq_cascade_t none, lf;
+    CHECK(pll_bq_init(&none, NULL, 0) == 0);
+    CHECK(pll_bq_init(&lf, pass, PLL_BQ_MAX) == 0);
+    pll_q30_state_t a = *st0, b = *st0, p = *st0;
+    for (size_t i = 0; i < n; i++) {
+        pll_q30_step(&a, x[i]);
+        pll_q30_step_lf(&b, &none, x[i]);
+        pll_q30_step_lf(&p, &lf, x[i]);
+        CHECK(same_state(&a, &b) && same_state(&a, &p));
+    }
+#else
+    (void)st0;
+#endif
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    static int32_t x[MAX_SAMPLES], out_f[MAX_SAMPLES], out_blk[MAX_SAMPLES];
+    static uint64_t t_q32[MAX_SAMPLES + 1];
+
+    if (size < HDR_BYTES) return 0;
+    int32_t  kp    = rd32(data);
+    int32_t  ki    = rd32(data + 4);
+    int32_t  integ = rd32(data + 8);
+    uint32_t theta = (uint32_t)rd32(data + 12) & 0x3FFFFFFF;
+    unsigned split = (unsigned)data[16] | ((unsigned)data[17] << 8);
+    unsigned flip  = (unsigned)data[18] | ((unsigned)data[19] << 8);
+
+    size_t n = (size - HDR_BYTES) / 4;
+    if (n > MAX_SAMPLES) n = MAX_SAMPLES;
+    for (size_t i = 0; i < n; i++) x[i] = rd32(data + HDR_BYTES + 4 * i);
+
+    // ---- step vs reference, from an injected state ----
+    pll_q30_state_t a, b, c, d, e, a0;   // a0: initial state
+    pll_q30w_state_t w;
+    pll_q30_init(&a, kp, ki);
+    a.integrator_q30 = integ;
+    a.theta_q30 = theta;
+    b = a;
+    c = a;
+    e = a;
+    a0 = a;
+    pll_q30w_init(&w, kp, ki);
+    w.integrator_q30 = integ;
+    w.theta_q30 = theta;
+
+    int restored = 0, hdl_sat = 0;
+    split = n ? split % (unsigned)n : 0;
+    for (size_t i = 0; i < n; i++) {
+#if PLL_API_SNAPSHOT
+        if (i == split) {
+            check_snapshot(&a, flip, data + HDR_BYTES, size - HDR_BYTES);
+            pll_q30_snapshot_t snap;
+            pll_q30_save(&a, &snap);
+            CHECK(pll_q30_restore(&d, &snap) == 0);
+            restored = 1;
+        }
+#else
+        (void)flip;
+#endif
+        uint32_t th_prev = a.theta_q30;
+        pll_q30_step(&a, x[i]);
+        check_phase(&a, th_prev, (uint32_t)i + 1u);
+        hdl_sat |= pll_q30_ref_step(&b, x[i]) & Q30W_DIVERGE;
+        CHECK(a.theta_q30 <= 0x3FFFFFFFu);
+        CHECK(same_state(&a, &b));
+#if PLL_API_TS
+        pll_q30_step_dt(&e, x[i], PLL_INV_FS_Q32);
+        CHECK(same_state(&e, &a));
+#endif
+        pll_q30w_step(&w, x[i]);
+        CHECK(w.theta_q30 <= 0x3FFFFFFFu);
+        CHECK(w.integrator_q30 > -3 * ((int64_t)1 << 31) && w.integrator_q30 < 3 * ((int64_t)1 << 31));
+        if (!hdl_sat)
+            CHECK(w.out_f_q25 == a.out_f_q25 && w.theta_q30 == a.theta_q30 &&
+                  w.integrator_q30 == a.integrator_q30 && w.delta_f_q25 == a.delta_f_q25);
+        out_f[i] = a.out_f_q25;
+        if (restored) {
+            pll_q30_step(&d, x[i]);
+            CHECK(same_state(&d, &a));
+        }
+        if (i + 1 < n) check_helpers(x[i], x[i + 1]);
+    }
+
+    // ---- block API == per-sample ----
+#if PLL_API_BLOCK
+    pll_q30_step_block(&c, x, out_blk, n);
+    CHECK(same_state(&c, &a));
+    CHECK(memcmp(out_blk, out_f, n * sizeof out_f[0]) == 0);
+#else
+    (void)c;
+    (void)out_f;
+#endif
+
+    // ---- timestamped block API == per-sample step_dt, any spacing ----
+#if PLL_API_TS
+    {
+        pll_q30_state_t ts = a, dt = a;
+        t_q32[0] = (uint64_t)theta << 20;
+        for (size_t i = 0; i < n; i++) t_q32[i + 1] = t_q32[i] + (uint32_t)x[i];
+        pll_q30_step_block_ts(&ts, x, t_q32, out_blk, n);
+        for (size_t i = 0; i < n; i++) {
+            pll_q30_step_dt(&dt, x[i], (uint32_t)x[i]);
+            CHECK(dt.theta_q30 <= 0x3FFFFFFFu);
+            CHECK(out_blk[i] == dt.out_f_q25);
+        }
+        CHECK(same_state(&ts, &dt));
+    }
+#else
+    (void)e;
+    (void)t_q32;
+#endif
+#if !PLL_API_BLOCK && !PLL_API_TS
+    (void)out_blk;
+#endif
+#if PLL_FS_TRIM && PLL_API_TS
+    {
+        pll_q30_state_t tr = a0, dt = a0;
+        uint32_t inv = (uint32_t)ki & 0x00FFFFFFu;                 // any 24-bit reciprocal
+        tr.inv_fs_q40 = inv << PLL_INV_FS_FRAC;
+        for (size_t i = 0; i < n; i++) {
+            uint32_t th_prev = tr.theta_q30;
+            pll_q30_step(&tr, x[i]);
+            check_phase(&tr, th_prev, (uint32_t)i + 1u);
+            pll_q30_step_dt(&dt, x[i], inv);
+            CHECK(same_state(&tr, &dt));
+        }
+    }
+#endif
+
+    // ---- other engines: invariants / bank vs scalar ----
+    if (n) {
+        pll_f32_state_t f;
+        pll_f32_init(&f, kp, ki);
+        for (size_t i = 0; i < n; i++) {
+            pll_f32_step(&f, x[i]);
+            CHECK(pll_f32_theta_q30(&f) <= 0x3FFFFFFFu);
+        }
+        check_q15_bank(kp, ki, x, n < 512 ? n : 512);
+        check_ref(a.theta_q30, x, n);
+        check_ipark(&a0, x, n);
+        check_power(x, n);
+        check_resamp(x, n);
+        check_sdft(x, n);
+        check_biquad(&a0, x, n);
+    }
+    return 0;
+}
+
+#ifndef PLL_FUZZ_LIBFUZZER
+static uint64_t splitmix(uint64_t *s)
+{
+    uint64_t z = (*s += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static int run_file(FILE *f)
+{
+    static uint8_t buf[HDR_BYTES + 4 * MAX_SAMPLES];
+    size_t n = fread(buf, 1, sizeof buf, f);
+    return LLVMFuzzerTestOneInput(buf, n);
+}
+
+int main(int argc, char **argv)
+{
+    // -r N: random inputs without a fuzzer (smoke run for sanitizer builds)
+    if (argc > 2 && strcmp(argv[1], "-r") == 0) {
+        static uint8_t buf[HDR_BYTES + 4 * 1024];
+        long iters = atol(argv[2]);
+        uint64_t s = 1;
+        for (long it = 0; it < iters; it++) {
+            size_t len = HDR_BYTES + (size_t)(splitmix(&s) % (sizeof buf - HDR_BYTES + 1));
+            for (size_t i = 0; i < len; i += 8) {
+                uint64_t r = splitmix(&s);
+                // bias toward extremes so saturation paths are hit
+                if ((r & 7) == 0) r = (r & 8) ? 0x8000000080000000ull : 0x7FFFFFFF7FFFFFFFull;
+                memcpy(buf + i, &r, (len - i) < 8 ? len - i : 8);
+            }
+            LLVMFuzzerTestOneInput(buf, len);
+        }
+        printf("fuzz_pll_q30: %ld random inputs ok\n", iters);
+        return 0;
+    }
+
+    if (argc < 2) return run_file(stdin);            // AFL: input on stdin
+    for (int i = 1; i < argc; i++) {
+        FILE *f = fopen(argv[i], "rb");
+        if (!f) { perror(argv[i]); return 1; }
+        run_file(f);
+        fclose(f);
+    }
+    return 0;
+}
+#endif
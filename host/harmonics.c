@@ -0,0 +1,183 @@
+// Harmonic analysis on the grid-synchronous resampler (pll_resamp.h), against
+// a plain DFT of the raw samples.
+//
+// A producer thread plays the sampling context: it generates a distorted
+// grid voltage (fundamental plus odd harmonics), steps the loop and pushes
+// every sample into the resampler. A consumer thread plays the analysis
+// side: it pops PLL_RS_N-point blocks from the lock-free queue and takes a
+// rectangular DFT of each, so bin h is harmonic h exactly. The comparison is
+// the same DFT over a window of Fs / f_nominal raw samples, which leaks when
+// the grid is off nominal. Reported per bin 1..H, over the last third of
+// the run (the loop needs several seconds to settle at these gains):
+//   sync  : max |amplitude - true| over all blocks (zero-truth bins: leakage)
+//   async : the same for consecutive raw windows of round(Fs / 50) samples
+// plus the producer's drop / overrun counters and the frequency from the
+// block periods.
+//
+// Build: cc -O2 -msse4.1 -pthread -I.. -o harmonics harmonics.c ../pll_resamp.c ../pll_q30.c -lm
+// Run  : ./harmonics [-f f_hz] [-s seconds]      (default 50.2 Hz, 12 s)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "pll_config.h"
+#include "pll_q30.h"
+#include "pll_resamp.h"
+
+#define KP_Q30     0x20000000
+#define KI_Q30     0x00147AE1
+#define Q22        4194304.0
+#define H          15
+#define F_NOM      50.0
+
+static const double amp[H + 1] = { [1] = 0.9, [3] = 0.05, [5] = 0.04, [7] = 0.03, [11] = 0.01, [13] = 0.008 };
+static const double phs[H + 1] = { [3] = 0.3, [5] = 1.1, [7] = -0.7, [11] = 2.0, [13] = -2.5 };
+
+static double   f_in = 50.2;
+static long     n_samples, settle;
+static double  *raw;                        // input, for the async windows
+static pll_rs_t rs;
+static int      done_flag;
+
+// rectangular DFT, bins 1..H; tw: cos/sin of 2 pi m / n, m < n
+static void dft_amp(const double *x, long n, const double *twc, const double *tws, double *a)
+{
+    for (int h = 1; h <= H; h++) {
+        double re = 0.0, im = 0.0;
+        for (long j = 0, m = 0; j < n; j++, m = (m + h) % n) {
+            re += x[j] * twc[m];
+            im -= x[j] * tws[m];
+        }
+        a[h] = 2.0 * hypot(re, im) / (double)n;
+    }
+}
+
+static void twiddles(long n, double *twc, double *tws)
+{
+    for (long m = 0; m < n; m++) {
+        twc[m] = cos(2.0 * M_PI * (double)m / (double)n);
+        tws[m] = sin(2.0 * M_PI * (double)m / (double)n);
+    }
+}
+
+static void *producer(void *arg)
+{
+    (void)arg;
+    pll_q30_state_t st;
+    pll_q30_init(&st, KP_Q30, KI_Q30);
+    double ph = 0.0;
+    for (long k = 0; k < n_samples; k++) {
+        double x = 0.0;
+        for (int h = 1; h <= H; h++)
+            if (amp[h] != 0.0) x += amp[h] * sin(2.0 * M_PI * h * ph + phs[h]);
+        raw[k] = x;
+        ph += f_in / PLL_FS_HZ;
+        ph -= floor(ph);
+
+        int32_t xq = (int32_t)lrint(x * Q22);
+        pll_q30_step(&st, xq);
+        // a real sampling context leaves the CPU between samples; hand it
+        // over once per cycle so one core runs the demo without drops
+        if (pll_rs_step(&rs, &st, xq)) sched_yield();
+    }
+    __atomic_store_n(&done_flag, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+typedef struct {
+    double err[H + 1];
+    double period_s, period_s2;
+    long   blocks, used;
+    uint32_t last_cycle, gaps;
+} consumer_t;
+
+static void *consumer(void *arg)
+{
+    consumer_t *c = arg;
+    double x[PLL_RS_N], a[H + 1], twc[PLL_RS_N], tws[PLL_RS_N];
+    const uint32_t skip = (uint32_t)(settle * f_in / PLL_FS_HZ);   // cycles before the settled span
+    twiddles(PLL_RS_N, twc, tws);
+    for (;;) {
+        int fin = __atomic_load_n(&done_flag, __ATOMIC_ACQUIRE);
+        const pll_rs_block_t *b = pll_rs_peek(&rs);
+        if (!b) {
+            if (fin) break;
+            sched_yield();
+            continue;
+        }
+        c->blocks++;
+        if (c->last_cycle && b->cycle != c->last_cycle + 1) c->gaps++;
+        c->last_cycle = b->cycle;
+        if (b->cycle > skip) {
+            for (uint32_t j = 0; j < PLL_RS_N; j++) x[j] = b->x_q22[j] / Q22;
+            dft_amp(x, PLL_RS_N, twc, tws, a);
+            for (int h = 1; h <= H; h++) c->err[h] = fmax(c->err[h], fabs(a[h] - amp[h]));
+            double p = b->period_q16 / 65536.0;
+            c->period_s += p;
+            c->period_s2 += p * p;
+            c->used++;
+        }
+        pll_rs_release(&rs);
+    }
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    int seconds = 12;
+    for (int i = 1; i < argc; i++) {
+        if      (!strcmp(argv[i], "-f") && i + 1 < argc) f_in = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) seconds = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [-f f_hz] [-s seconds]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (seconds < 3) seconds = 3;
+    n_samples = (long)seconds * PLL_FS_HZ;
+    settle = n_samples * 2 / 3;
+    const long L = lrint(PLL_FS_HZ / F_NOM);
+    raw = malloc((size_t)n_samples * sizeof *raw);
+    double *twc = malloc((size_t)L * sizeof *twc), *tws = malloc((size_t)L * sizeof *tws);
+    if (!raw || !twc || !tws) return 1;
+
+    pll_rs_init(&rs);
+    consumer_t c;
+    memset(&c, 0, sizeof c);
+    pthread_t tp, tc;
+    pthread_create(&tc, NULL, consumer, &c);
+    pthread_create(&tp, NULL, producer, NULL);
+    pthread_join(tp, NULL);
+    pthread_join(tc, NULL);
+
+    // async: consecutive nominal-length windows over the same settled span
+    double e_async[H + 1] = {0}, a[H + 1];
+    twiddles(L, twc, tws);
+    long windows = 0;
+    for (long k = settle; k + L <= n_samples; k += L, windows++) {
+        dft_amp(raw + k, L, twc, tws, a);
+        for (int h = 1; h <= H; h++) e_async[h] = fmax(e_async[h], fabs(a[h] - amp[h]));
+    }
+
+    double pm = c.used ? c.period_s / c.used : 0.0;
+    double pr = c.used ? sqrt(fmax(c.period_s2 / c.used - pm * pm, 0.0)) : 0.0;
+    printf("input %.3f Hz, Fs %d Hz, %d s (settled from %ld s), %u points/cycle\n", f_in, PLL_FS_HZ, seconds,
+           settle / PLL_FS_HZ, PLL_RS_N);
+    printf("  %ld blocks (%ld analysed, %u cycles, %u dropped, %u overruns, %u gaps seen)\n",
+           c.blocks, c.used, rs.cycle, rs.dropped, rs.overruns, c.gaps);
+    if (pm > 0.0)
+        printf("  f from block periods: %.6f Hz (period rms %.4f samples)\n", PLL_FS_HZ / pm, pr);
+    printf("  %2s %8s %12s %12s  (async: %ld windows of %ld samples)\n", "h", "true", "sync err", "async err",
+           windows, L);
+    for (int h = 1; h <= H; h++)
+        printf("  %2d %8.4f %12.3e %12.3e\n", h, amp[h], c.err[h], e_async[h]);
+    free(raw);
+    free(twc);
+    free(tws);
+    return 0;
+}
@@ -0,0 +1,176 @@
+// Biquad loop filter (pll_biquad.h) on host: designs and the loop with it.
+//
+// 1) The compile-time designs against the same filters in double (libm
+//    cos/sin): gain of the Q30 cascade measured with a tone (rms over whole
+//    periods after the transient) vs |H(e^jw)|, at a few frequencies each.
+// 2) pll_q30 on a single-phase input (0.9 pu, 5 % 5th harmonic, optional
+//    noise) with -f f_hz, plain (pll_q30_step) and with notches at 2f, 4f
+//    and 6f of the nominal 50 Hz before the PI (pll_q30_step_lf): out_f_q25
+//    ripple over the last quarter of the run, mean error, and the time from
+//    which the error stays within 25 mHz. The multiplier detector's 2f term
+//    dominates the plain loop's ripple; the 5th harmonic adds 4f and 6f.
+//
+// Build: cc -O2 -I.. -o loop_filter loop_filter.c ../pll_biquad.c ../pll_q30.c -lm
+// Run  : ./loop_filter [-f f_hz] [-n noise_pu] [-s seconds]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "pll_config.h"
+#include "pll_q30.h"
+#include "pll_biquad.h"
+
+#define KP_Q30     0x20000000
+#define KI_Q30     0x00147AE1
+#define Q22        4194304.0
+#define Q25        33554432.0
+#define Q30        1073741824.0
+#define SETTLE_HZ  0.025
+
+static const pll_bq_coef_t notches[] = { PLL_BQ_NOTCH(100.0, 2.0), PLL_BQ_NOTCH(200.0, 2.0),
+                                         PLL_BQ_NOTCH(300.0, 2.0) };
+
+typedef struct {
+    const char   *name;
+    pll_bq_coef_t c;
+    double        b[3], a[3];           // double design, a[0] = 1
+    double        f[4];                 // test frequencies, Hz
+} design_t;
+
+static void rbj(design_t *d, int lpf, double f0, double q)
+{
+    double w = 2.0 * M_PI * f0 / PLL_FS_HZ, al = sin(w) / (2.0 * q), a0 = 1.0 + al;
+    if (lpf) {
+        d->b[0] = d->b[2] = (1.0 - cos(w)) / 2.0 / a0;
+        d->b[1] = (1.0 - cos(w)) / a0;
+    } else {
+        d->b[0] = d->b[2] = 1.0 / a0;
+        d->b[1] = -2.0 * cos(w) / a0;
+    }
+    d->a[0] = 1.0;
+    d->a[1] = -2.0 * cos(w) / a0;
+    d->a[2] = (1.0 - al) / a0;
+}
+
+static void leadlag(design_t *d, double fz, double fp)
+{
+    double c = 2.0 * PLL_FS_HZ, wz = c / (2.0 * M_PI * fz), wp = c / (2.0 * M_PI * fp);
+    d->b[0] = (1.0 + wz) / (1.0 + wp);
+    d->b[1] = (1.0 - wz) / (1.0 + wp);
+    d->b[2] = 0.0;
+    d->a[0] = 1.0;
+    d->a[1] = (1.0 - wp) / (1.0 + wp);
+    d->a[2] = 0.0;
+}
+
+static double gain_double(const design_t *d, double f)
+{
+    double w = 2.0 * M_PI * f / PLL_FS_HZ;
+    double nr = d->b[0] + d->b[1] * cos(w) + d->b[2] * cos(2 * w), ni = -d->b[1] * sin(w) - d->b[2] * sin(2 * w);
+    double dr = d->a[0] + d->a[1] * cos(w) + d->a[2] * cos(2 * w), di = -d->a[1] * sin(w) - d->a[2] * sin(2 * w);
+    return sqrt((nr * nr + ni * ni) / (dr * dr + di * di));
+}
+
+// rms out / rms in of a 0.05 pu (Q30) tone after 2 s of transient (the
+// lead-lag gains up to 10: stays clear of saturation)
+static double gain_q30(const pll_bq_coef_t *c, double f)
+{
+    pll_bq_cascade_t bq;
+    pll_bq_init(&bq, c, 1);
+    const long skip = 2L * PLL_FS_HZ, per = lrint(PLL_FS_HZ / f), len = per * (long)ceil(f);
+    double si = 0.0, so = 0.0;
+    for (long k = 0; k < skip + len; k++) {
+        int32_t x = (int32_t)lrint(0.05 * Q30 * sin(2.0 * M_PI * f * k / PLL_FS_HZ));
+        int32_t y = pll_bq_run(&bq, x);
+        if (k < skip) continue;
+        si += (double)x * x;
+        so += (double)y * y;
+    }
+    return sqrt(so / si);
+}
+
+static double db(double g) { return 20.0 * log10(g > 1e-12 ? g : 1e-12); }
+
+typedef struct { double s, s2, mx; long n, settle; } run_t;
+
+static void run_loop(int filt, double f, double noise, int seconds, run_t *r)
+{
+    pll_q30_state_t st;
+    pll_bq_cascade_t lf;
+    pll_q30_init(&st, KP_Q30, KI_Q30);
+    pll_bq_init(&lf, notches, sizeof notches / sizeof notches[0]);
+    const long n = (long)seconds * PLL_FS_HZ, last = n - n / 4;
+    double ph = 0.0;
+    uint32_t seed = 1;
+    memset(r, 0, sizeof *r);
+    r->settle = -1;
+    for (long k = 0; k < n; k++) {
+        double w = 2.0 * M_PI * ph, v = 0.9 * sin(w) + 0.05 * sin(5 * w);
+        if (noise > 0.0) {
+            seed = seed * 1664525u + 1013904223u;
+            v += noise * ((double)seed / 4294967296.0 - 0.5) * sqrt(12.0);
+        }
+        ph += f / PLL_FS_HZ;
+        ph -= floor(ph);
+        int32_t x = (int32_t)lrint(v * Q22);
+        if (filt) pll_q30_step_lf(&st, &lf, x);
+        else      pll_q30_step(&st, x);
+        double e = st.out_f_q25 / Q25 - f;
+        if (fabs(e) > SETTLE_HZ) r->settle = -1;
+        else if (r->settle < 0) r->settle = k;
+        if (k < last) continue;
+        r->s += e;
+        r->s2 += e * e;
+        if (fabs(e) > r->mx) r->mx = fabs(e);
+        r->n++;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    double f = 50.0, noise = 0.0;
+    int    seconds = 20;
+
+    for (int i = 1; i < argc; i++) {
+        if      (!strcmp(argv[i], "-f") && i + 1 < argc) f = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc) noise = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) seconds = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [-f f_hz] [-n noise_pu] [-s seconds]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (seconds < 4) seconds = 4;
+
+    design_t d[] = {
+        { "notch 100 Hz q 2", PLL_BQ_NOTCH(100.0, 2.0), {0}, {0}, { 10.0, 75.0, 100.0, 400.0 } },
+        { "lpf 500 Hz q .707", PLL_BQ_LPF(500.0, 0.7071), {0}, {0}, { 50.0, 500.0, 2000.0, 8000.0 } },
+        { "lead-lag 5/50 Hz", PLL_BQ_LEADLAG(5.0, 50.0), {0}, {0}, { 1.0, 5.0, 16.0, 200.0 } },
+    };
+    rbj(&d[0], 0, 100.0, 2.0);
+    rbj(&d[1], 1, 500.0, 0.7071);
+    leadlag(&d[2], 5.0, 50.0);
+
+    printf("designs at Fs %d Hz: Q30 cascade (measured) vs double, dB\n", PLL_FS_HZ);
+    for (size_t i = 0; i < sizeof d / sizeof d[0]; i++) {
+        printf("  %-18s shift %d:", d[i].name, (int)d[i].c.shift);
+        for (int j = 0; j < 4; j++)
+            printf("  %6.0f Hz %+8.3f/%+8.3f", d[i].f[j], db(gain_q30(&d[i].c, d[i].f[j])), db(gain_double(&d[i], d[i].f[j])));
+        printf("\n");
+    }
+
+    printf("loop, input %.3f Hz, noise %.3f pu, %d s (stats over the last quarter)\n", f, noise, seconds);
+    for (int filt = 0; filt < 2; filt++) {
+        run_t r;
+        run_loop(filt, f, noise, seconds, &r);
+        double nn = r.n ? (double)r.n : 1.0;
+        printf("  %-22s mean %+8.3f  rms %8.3f  max %8.3f mHz  settled(25 mHz) ", filt ? "notch 100/200/300 Hz" : "plain",
+               1e3 * r.s / nn, 1e3 * sqrt(r.s2 / nn), 1e3 * r.mx);
+        if (r.settle >= 0) printf("%.2f s\n", (double)r.settle / PLL_FS_HZ);
+        else               printf("no\n");
+    }
+    return 0;
+}
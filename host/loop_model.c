@@ -0,0 +1,105 @@
+// Small-signal model of the pll_q30 loop: coefficients and margins.
+//
+// Prints the discrete-time transfer functions implied by the gains, Fs, the
+// Q-format shifts in pll_config.h and the decimation (see pll_q30_model.h),
+// with the closed-loop poles, phase/gain margin, peaking and bandwidth.
+// Milliseconds instead of a time-domain run; host/bode.c -model overlays the
+// same model on the measured response.
+//
+// Output formats (-o):
+//   text   : summary (default)
+//   csv    : name,b0,b1,b2,a0,a1,a2,ts
+//   py     : dict of (b, a, dt) tuples for scipy.signal.dlti
+//   m      : MATLAB/Octave tf(b, a, Ts, 'Variable', 'z^-1') lines
+//
+// Build: cc -O2 -I.. -o loop_model loop_model.c pll_q30_model.c -lm
+// Run  : ./loop_model [-k kp_q30 ki_q30] [-a amp] [-fs Hz] [-D decim] [-o text|csv|py|m]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "pll_config.h"
+#include "pll_q30_model.h"
+
+static void print_coefs(const char *fmt, const pll_q30_model_t *m)
+{
+    const double ts = 1.0 / m->fs_loop;
+    if (!strcmp(fmt, "csv")) printf("name,b0,b1,b2,a0,a1,a2,ts\n");
+    if (!strcmp(fmt, "py"))  printf("pll = {\n");
+    for (int t = 0; t < PLL_MODEL_N; t++) {
+        const double *b = m->tf[t].b, *a = m->tf[t].a;
+        const char *nm = pll_model_tf_name[t];
+        if (!strcmp(fmt, "csv"))
+            printf("%s,%.17g,%.17g,%.17g,%.17g,%.17g,%.17g,%.17g\n", nm, b[0], b[1], b[2], a[0], a[1], a[2], ts);
+        else if (!strcmp(fmt, "py"))
+            printf("    '%s': ([%.17g, %.17g, %.17g], [%.17g, %.17g, %.17g], %.17g),\n",
+                   nm, b[0], b[1], b[2], a[0], a[1], a[2], ts);
+        else if (!strcmp(fmt, "m"))
+            printf("%s = tf([%.17g %.17g %.17g], [%.17g %.17g %.17g], %.17g, 'Variable', 'z^-1');\n",
+                   nm, b[0], b[1], b[2], a[0], a[1], a[2], ts);
+        else
+            printf("  %-4s b = [% .9e % .9e % .9e]\n       a = [% .9e % .9e % .9e]\n",
+                   nm, b[0], b[1], b[2], a[0], a[1], a[2]);
+    }
+    if (!strcmp(fmt, "py")) printf("}\n");
+}
+
+int main(int argc, char **argv)
+{
+    int32_t kp = 0x20000000, ki = 0x00147AE1;
+    double  amp = 0.9, fs = PLL_FS_HZ;
+    int     decim = 1;
+    const char *fmt = "text";
+
+    for (int i = 1; i < argc; i++) {
+        if      (!strcmp(argv[i], "-k")  && i + 2 < argc) { kp = (int32_t)strtol(argv[i + 1], NULL, 0);
+                                                           ki = (int32_t)strtol(argv[i + 2], NULL, 0); i += 2; }
+        else if (!strcmp(argv[i], "-a")  && i + 1 < argc) amp = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-fs") && i + 1 < argc) fs = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-D")  && i + 1 < argc) decim = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-o")  && i + 1 < argc) fmt = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [-k kp_q30 ki_q30] [-a amp] [-fs Hz] [-D decim] [-o text|csv|py|m]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    pll_q30_model_t m;
+    if (pll_q30_model_build(&m, kp, ki, amp, fs, decim) != 0) {
+        fprintf(stderr, "invalid parameters\n");
+        return 2;
+    }
+    if (strcmp(fmt, "text")) {
+        if (strcmp(fmt, "csv") && strcmp(fmt, "py") && strcmp(fmt, "m")) {
+            fprintf(stderr, "unknown format %s\n", fmt);
+            return 2;
+        }
+        print_coefs(fmt, &m);
+        return 0;
+    }
+
+    pll_model_poles_t p;
+    pll_model_margins_t mg;
+    pll_q30_model_poles(&m, &p);
+    pll_q30_model_margins(&m, &mg);
+
+    printf("kp_q30 0x%08X (%.6f)  ki_q30 0x%08X (%.6f)  amp %.3f\n",
+           (unsigned)kp, m.kp, (unsigned)ki, m.ki, amp);
+    printf("Fs %.1f Hz / %d -> loop %.1f Hz, inv_fs_q32 %u\n", fs, decim, m.fs_loop, (unsigned)m.inv_fs_q32);
+    printf("shifts: x << %d, u >> %d, inc >> %d\n", PLL_X_SHIFT, PLL_DF_SHIFT, PLL_INC_SHIFT);
+    printf("Kd %.6f /turn  Ku %.6f Hz  Kv %.6e turn/Hz  g %.6e\n\n", m.kd, m.ku, m.kv, m.g);
+    printf("transfer functions, b(z^-1) / a(z^-1):\n");
+    print_coefs(fmt, &m);
+
+    printf("\nclosed-loop poles: %.9f %+.9fj, %.9f %+.9fj  |p|max %.9f (%s)\n",
+           p.re[0], p.im[0], p.re[1], p.im[1], p.max_radius, p.max_radius < 1.0 ? "stable" : "UNSTABLE");
+    printf("  fn %.4f Hz  zeta %.4f\n", p.fn_hz, p.zeta);
+    printf("margins: crossover %.4f Hz, PM %.2f deg; ", mg.fc_hz, mg.pm_deg);
+    if (isnan(mg.f180_hz)) printf("no phase crossover below Fs/2 (GM infinite)\n");
+    else                   printf("phase crossover %.4f Hz, GM %.2f dB\n", mg.f180_hz, mg.gm_db);
+    printf("closed loop: peak %.2f dB at %.4f Hz, -3 dB at %.4f Hz\n", mg.peak_db, mg.peak_hz, mg.bw3_hz);
+    return 0;
+}
@@ -0,0 +1,123 @@
+// Host model of memory stalls in pll_q30_step: caches + AXI vs TCM placement.
+//
+// Replays the real instruction-line and NCO-table access pattern of the loop
+// (table indices come from running pll_q30_step) through direct-mapped I/D
+// cache models. Between samples, "other control code" evicts a configurable
+// number of random lines, which is what makes the default placement jittery.
+// With -DPLL_USE_TCM both streams hit local memory at fixed latency.
+//
+// Build: cc -O2 -I.. -o memlat_model memlat_model.c ../pll_q30.c
+// Run  : ./memlat_model [code_bytes] [miss_penalty_cyc]
+//        code_bytes: size of pll_q30_step from host/size_report.sh (default 400)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "pll_q30.h"
+#include "sine_q230_1024.h"
+
+#define FS_HZ      40000u
+#define FIN_HZ     50u
+#define SAMPLES    40000
+
+#define ICACHE_BYTES  8192u
+#define DCACHE_BYTES  8192u
+#define LINE_BYTES    32u
+#define TCM_LAT       0u     // extra cycles for a TCM access (LMB: single cycle)
+
+typedef struct {
+    uint32_t nlines;
+    uint32_t tag[ICACHE_BYTES / LINE_BYTES > DCACHE_BYTES / LINE_BYTES ?
+                 ICACHE_BYTES / LINE_BYTES : DCACHE_BYTES / LINE_BYTES];
+} dm_cache_t;
+
+static void cache_init(dm_cache_t *c, uint32_t bytes)
+{
+    c->nlines = bytes / LINE_BYTES;
+    memset(c->tag, 0xFF, sizeof(c->tag));
+}
+
+// returns 1 on miss
+static int cache_access(dm_cache_t *c, uint32_t addr)
+{
+    uint32_t line = addr / LINE_BYTES;
+    uint32_t set  = line % c->nlines;
+    if (c->tag[set] == line) return 0;
+    c->tag[set] = line;
+    return 1;
+}
+
+static uint32_t rng = 0x12345678u;
+static uint32_t xorshift(void)
+{
+    rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+    return rng;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t code_bytes = (argc > 1) ? (uint32_t)atoi(argv[1]) : 400u;
+    uint32_t penalty    = (argc > 2) ? (uint32_t)atoi(argv[2]) : 20u;
+
+    // Default-linker-script picture: code and table somewhere in DDR/OCM
+    const uint32_t CODE_BASE  = 0x80001240u;
+    const uint32_t TABLE_BASE = 0x80013a80u;
+    const uint32_t OTHER_BASE = 0x80100000u;   // unrelated control code/data
+
+    const uint32_t phase_step = (uint32_t)(((uint64_t)FIN_HZ << 32) / FS_HZ);
+    const uint32_t code_lines = (code_bytes + LINE_BYTES - 1) / LINE_BYTES;
+    const uint32_t interf[] = { 0, 16, 64, 256 };
+
+    printf("code=%u B (%u lines)  line=%u B  I$=%u B  D$=%u B  miss=%u cyc\n",
+           code_bytes, code_lines, LINE_BYTES, ICACHE_BYTES, DCACHE_BYTES, penalty);
+    printf("%10s | %14s %10s | %14s %10s\n", "evict/smp", "cached avg", "worst", "TCM avg", "worst");
+
+    for (size_t k = 0; k < sizeof(interf) / sizeof(interf[0]); k++) {
+        dm_cache_t ic, dc;
+        cache_init(&ic, ICACHE_BYTES);
+        cache_init(&dc, DCACHE_BYTES);
+
+        pll_q30_state_t st;
+        pll_q30_init(&st, 0x20000000, 0x00147AE1);
+
+        uint32_t phase = 0;
+        uint64_t stall_sum = 0;
+        uint32_t stall_max = 0;
+
+        for (int i = 0; i < SAMPLES; i++) {
+            uint32_t stall = 0;
+
+            // instruction stream: straight-line walk of the step body
+            for (uint32_t l = 0; l < code_lines; l++)
+                stall += cache_access(&ic, CODE_BASE + l * LINE_BYTES) * penalty;
+
+            // data stream: the two NCO lookups this sample makes
+            uint32_t idx = (st.theta_q30 >> 20) & (SINE_N - 1);
+            stall += cache_access(&dc, TABLE_BASE + 4u * idx) * penalty;
+            stall += cache_access(&dc, TABLE_BASE + 4u * ((idx + 256) & (SINE_N - 1))) * penalty;
+
+            pll_q30_step(&st, sine_q230[phase >> 22] >> 8);
+            phase += phase_step;
+
+            if (i > 0) {     // first sample is a cold start in both cases
+                stall_sum += stall;
+                if (stall > stall_max) stall_max = stall;
+            }
+
+            // unrelated code between samples
+            for (uint32_t e = 0; e < interf[k]; e++) {
+                uint32_t a = OTHER_BASE + (xorshift() % (64u * 1024u));
+                if (e & 1u) cache_access(&ic, a);
+                else        cache_access(&dc, a);
+            }
+        }
+
+        // TCM: every fetch/load at fixed latency, independent of history
+        uint32_t tcm = (code_lines * (LINE_BYTES / 4u) + 2u) * TCM_LAT;
+        printf("%10u | %14.2f %10u | %14u %10u\n", interf[k],
+               (double)stall_sum / (SAMPLES - 1), stall_max, tcm, tcm);
+    }
+    return 0;
+}
@@ -0,0 +1,139 @@
+// Host-only. The per-block passes vectorize at -O2/-O3 once the compiler may
+// if-convert the clamps: add -fno-trapping-math (and -march=native) when the
+// front end is on a hot path, e.g. Monte Carlo runs.
+
+#include "pll_frontend.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCK 256
+
+static uint64_t xorshift64s(uint64_t *s)
+{
+    uint64_t x = *s ? *s : 0x9E3779B97F4A7C15ull;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *s = x;
+    return x * 0x2545F4914F6CDD1Dull;
+}
+
+// n standard normal deviates (Box-Muller, pairs)
+static void normals(uint64_t *rng, double *z, size_t n)
+{
+    for (size_t i = 0; i < n; i += 2) {
+        double u1 = ((xorshift64s(rng) >> 11) + 1.0) * 0x1.0p-53;      // (0, 1]
+        double u2 = (xorshift64s(rng) >> 11) * 0x1.0p-53;
+        double r = sqrt(-2.0 * log(u1));
+        z[i] = r * cos(2.0 * M_PI * u2);
+        if (i + 1 < n) z[i + 1] = r * sin(2.0 * M_PI * u2);
+    }
+}
+
+int pll_fe_parse(pll_fe_t *fe, const char *spec)
+{
+    if (!fe || !spec) return -1;
+    if (!strcmp(spec, "board")) { *fe = PLL_FE_BOARD; return 0; }
+    *fe = PLL_FE_IDEAL;
+    if (!strcmp(spec, "ideal") || !*spec) return 0;
+
+    char buf[256];
+    if (strlen(spec) >= sizeof buf) return -1;
+    strcpy(buf, spec);
+    for (char *tok = strtok(buf, ","); tok; tok = strtok(NULL, ",")) {
+        char *eq = strchr(tok, '=');
+        if (!eq) return -1;
+        *eq = 0;
+        char *end;
+        double v = strtod(eq + 1, &end);
+        if (end == eq + 1 || *end) return -1;
+        if      (!strcmp(tok, "bits")) fe->bits = (int)v;
+        else if (!strcmp(tok, "off"))  fe->offset = v;
+        else if (!strcmp(tok, "gain")) fe->gain_err = v;
+        else if (!strcmp(tok, "inl2")) fe->inl2_lsb = v;
+        else if (!strcmp(tok, "inl3")) fe->inl3_lsb = v;
+        else if (!strcmp(tok, "jit"))  fe->jitter_rms_s = v;
+        else if (!strcmp(tok, "ap"))   fe->aperture_s = v;
+        else return -1;
+    }
+    if (fe->bits < 0 || fe->bits > 23 || fe->jitter_rms_s < 0.0) return -1;   // Q22 holds 23 bits over +-FS
+    return 0;
+}
+
+void pll_fe_describe(const pll_fe_t *fe, char *buf, size_t len)
+{
+    if (!fe || !buf || !len) return;
+    if (fe->bits) snprintf(buf, len, "%d-bit", fe->bits);
+    else          snprintf(buf, len, "ideal Q22");
+    size_t k = strlen(buf);
+    if (fe->offset != 0.0 || fe->gain_err != 0.0 || fe->inl2_lsb != 0.0 || fe->inl3_lsb != 0.0 ||
+        fe->jitter_rms_s != 0.0 || fe->aperture_s != 0.0)
+        snprintf(buf + k, len - k, ", off %g, gain %+g, INL %g/%g LSB, jitter %g s, aperture %g s",
+                 fe->offset, fe->gain_err, fe->inl2_lsb, fe->inl3_lsb, fe->jitter_rms_s, fe->aperture_s);
+}
+
+void pll_fe_convert(const pll_fe_t *fe, uint64_t *rng, const double *v, const double *dvdt,
+                    int32_t *x_q22, size_t n)
+{
+    if (!fe || !v || !x_q22) return;
+    const double lsb   = fe->bits ? 2.0 / (double)(1 << fe->bits) : 1.0 / (1 << 22);
+    const double g     = 1.0 + fe->gain_err, off = fe->offset;
+    const double k2    = fe->inl2_lsb * lsb, k3 = fe->inl3_lsb * lsb * 2.598076211353316;   // 3 sqrt(3) / 2
+    const double cmax  = fe->bits ? (double)((1 << (fe->bits - 1)) - 1) : 2147483647.0 / (1 << 22) / lsb;
+    const double cmin  = fe->bits ? -(double)(1 << (fe->bits - 1)) : -2147483648.0 / (1 << 22) / lsb;
+    const double q22   = lsb * (1 << 22);
+    const int timing   = dvdt && (fe->jitter_rms_s != 0.0 || fe->aperture_s != 0.0);
+    const int inl      = k2 != 0.0 || k3 != 0.0;
+    double w[BLOCK], z[BLOCK];
+
+    for (size_t b = 0; b < n; b += BLOCK) {
+        size_t m = (n - b < BLOCK) ? n - b : BLOCK;
+        const double *vb = v + b;
+
+        if (timing) {
+            const double *d = dvdt + b;
+            if (fe->jitter_rms_s != 0.0) normals(rng, z, m);
+            else                         memset(z, 0, m * sizeof z[0]);
+            for (size_t i = 0; i < m; i++)
+                w[i] = vb[i] + d[i] * (fe->aperture_s + fe->jitter_rms_s * z[i]);
+        } else {
+            memcpy(w, vb, m * sizeof w[0]);
+        }
+        for (size_t i = 0; i < m; i++) w[i] = w[i] * g + off;
+        if (inl)
+            for (size_t i = 0; i < m; i++) {
+                double u = w[i];
+                u = u < -1.0 ? -1.0 : u;
+                u = u > 1.0 ? 1.0 : u;
+                w[i] += k2 * (1.0 - u * u) + k3 * (u - u * u * u);
+            }
+        for (size_t i = 0; i < m; i++) {
+            double c = floor(w[i] / lsb + 0.5);
+            c = c < cmin ? cmin : c;
+            c = c > cmax ? cmax : c;
+            x_q22[b + i] = (int32_t)(c * q22);
+        }
+    }
+}
+
+double pll_fe_sine(const pll_fe_t *fe, uint64_t *rng, double amp, double f_hz, double fs_hz,
+                   double phase, int32_t *x_q22, size_t n)
+{
+    double v[BLOCK], d[BLOCK];
+    const double step = f_hz / fs_hz, dscale = 2.0 * M_PI * f_hz * amp;
+    for (size_t b = 0; b < n; b += BLOCK) {
+        size_t m = (n - b < BLOCK) ? n - b : BLOCK;
+        for (size_t i = 0; i < m; i++) {
+            double p = phase + step * (double)i;
+            v[i] = amp * sin(2.0 * M_PI * p);
+            d[i] = dscale * cos(2.0 * M_PI * p);
+        }
+        phase += step * (double)m;
+        phase -= floor(phase);
+        pll_fe_convert(fe, rng, v, d, x_q22 + b, m);
+    }
+    return phase;
+}
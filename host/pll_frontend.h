@@ -0,0 +1,62 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ADC front-end model for the host tools: ideal signal -> Q22 samples as the
+// board's converter would deliver them.
+//
+// Per sample, in this order (values in full-scale units, FS = +-1.0):
+//   1) timing : v += dv/dt * (aperture + jitter), jitter ~ N(0, jitter_rms)
+//               (first order in the time error; exact for ps..us at 50 Hz)
+//   2) gain/offset : v = v * (1 + gain_err) + offset
+//   3) INL    : v += lsb * (inl2 * (1 - u^2) + inl3 * 2.598 * (u - u^3)),
+//               u = v clipped to +-1: endpoint-fit bow and S-curve, peak
+//               inl2 / inl3 LSB
+//   4) quantize: clip to +-FS, round to bits (1..23, the most Q22 carries
+//               exactly; bits = 0: no quantization)
+// The stages are separate branch-free passes over a block, so the compiler
+// vectorizes them; the normal deviates come from a per-caller xorshift state.
+
+typedef struct {
+    int    bits;            // 1..23, 0 = ideal Q22
+    double offset;          // FS units
+    double gain_err;        // relative, 0.01 = +1 %
+    double inl2_lsb;        // bow, peak LSB
+    double inl3_lsb;        // S-curve, peak LSB
+    double jitter_rms_s;    // sample clock jitter, seconds rms
+    double aperture_s;      // fixed aperture delay, seconds
+} pll_fe_t;
+
+// No impairments, no quantization.
+#define PLL_FE_IDEAL ((pll_fe_t){ 0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 })
+
+// Board preset: datasheet-class figures for the 12-bit on-chip ADC path
+// (uncalibrated offset/gain, +-2 LSB INL, 1 ns jitter, 1.6 us acquisition);
+// replace with measured values once the board is characterised.
+#define PLL_FE_BOARD ((pll_fe_t){ 12, 0.004, 0.005, 1.5, 1.0, 1e-9, 1.6e-6 })
+
+// Parses "board", "ideal" or comma-separated key=value pairs on top of the
+// ideal front end: bits, off, gain, inl2, inl3, jit (s), ap (s).
+// e.g. "bits=12,off=0.002,inl2=1.5,jit=2e-9". Returns 0, or -1 on a bad spec.
+int  pll_fe_parse(pll_fe_t *fe, const char *spec);
+
+// One-line description, for tool headers.
+void pll_fe_describe(const pll_fe_t *fe, char *buf, size_t len);
+
+// Converts n ideal values v (with derivative dvdt, 1/s; NULL = timing
+// impairments off) to Q22. rng: xorshift state, any nonzero seed.
+void pll_fe_convert(const pll_fe_t *fe, uint64_t *rng, const double *v, const double *dvdt,
+                    int32_t *x_q22, size_t n);
+
+// Convenience: amp * sin(2 pi phase) at a constant frequency, phase in turns
+// at sample 0; returns the phase after n samples.
+double pll_fe_sine(const pll_fe_t *fe, uint64_t *rng, double amp, double f_hz, double fs_hz,
+                   double phase, int32_t *x_q22, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,166 @@
+#include "pll_q30_model.h"
+#include "pll_config.h"
+
+#include <math.h>
+#include <complex.h>
+#include <string.h>
+
+const char *const pll_model_tf_name[PLL_MODEL_N] = { "ol", "ef", "cl", "err", "ff" };
+
+int pll_q30_model_build(pll_q30_model_t *m, int32_t kp_q30, int32_t ki_q30,
+                        double amp, double fs_hz, int decim)
+{
+    if (!m || fs_hz <= 0.0 || decim < 1 || amp <= 0.0) return -1;
+    memset(m, 0, sizeof *m);
+
+    m->kp = kp_q30 / 1073741824.0;
+    m->ki = ki_q30 / 1073741824.0;
+    m->amp = amp;
+    m->fs = fs_hz;
+    m->decim = decim;
+    m->fs_loop = fs_hz / decim;
+    // same rounding as PLL_INV_FS_Q32
+    m->inv_fs_q32 = (uint32_t)floor(4294967296.0 / m->fs_loop + 0.5);
+
+    // Q22 full scale 1.0 -> Q30 value 2^(X_SHIFT + 22 - 30)
+    m->kd = M_PI * amp * ldexp(1.0, PLL_X_SHIFT + 22 - 30);
+    m->ku = ldexp(1.0, 5 - PLL_DF_SHIFT);
+    m->kv = m->inv_fs_q32 * ldexp(1.0, 25 - PLL_INC_SHIFT - 30);
+    m->g  = m->kd * m->ku * m->kv;
+
+    const double kp = m->kp, ki = m->ki, g = m->g;
+    pll_model_coef_t *t = m->tf;
+
+    // L = g [(kp+ki) z^-1 - kp z^-2] / (1 - z^-1)^2
+    t[PLL_MODEL_OL] = (pll_model_coef_t){ { 0.0, g * (kp + ki), -g * kp }, { 1.0, -2.0, 1.0 } };
+    // Kd Ku C = Kd Ku [(kp+ki) - kp z^-1] / (1 - z^-1)
+    t[PLL_MODEL_EF] = (pll_model_coef_t){ { m->kd * m->ku * (kp + ki), -m->kd * m->ku * kp, 0.0 },
+                                          { 1.0, -1.0, 0.0 } };
+    // den = (1 - z^-1)^2 + g [(kp+ki) z^-1 - kp z^-2]
+    double a1 = -2.0 + g * (kp + ki), a2 = 1.0 - g * kp;
+    t[PLL_MODEL_CL]  = (pll_model_coef_t){ { 0.0, g * (kp + ki), -g * kp }, { 1.0, a1, a2 } };
+    t[PLL_MODEL_ERR] = (pll_model_coef_t){ { 1.0, -2.0, 1.0 }, { 1.0, a1, a2 } };
+    double s = 1.0 / (m->kv * m->fs_loop);
+    t[PLL_MODEL_FF]  = (pll_model_coef_t){ { 0.0, s * g * (kp + ki), -s * g * kp }, { 1.0, a1, a2 } };
+    return 0;
+}
+
+static double complex eval(const pll_model_coef_t *c, double w)
+{
+    double complex zi = cexp(-I * w), num = 0.0, den = 0.0, p = 1.0;
+    for (int k = 0; k < PLL_MODEL_NCOEF; k++) {
+        num += c->b[k] * p;
+        den += c->a[k] * p;
+        p *= zi;
+    }
+    return num / den;
+}
+
+void pll_q30_model_resp(const pll_q30_model_t *m, pll_model_tf_t tf, double f_hz,
+                        double *mag, double *phase_deg)
+{
+    if (!m || tf >= PLL_MODEL_N) return;
+    double complex h = eval(&m->tf[tf], 2.0 * M_PI * f_hz / m->fs_loop);
+    if (mag) *mag = cabs(h);
+    if (phase_deg) *phase_deg = carg(h) * 180.0 / M_PI;
+}
+
+void pll_q30_model_poles(const pll_q30_model_t *m, pll_model_poles_t *p)
+{
+    if (!m || !p) return;
+    // z^2 + a1 z + a2 = 0
+    double a1 = m->tf[PLL_MODEL_CL].a[1], a2 = m->tf[PLL_MODEL_CL].a[2];
+    double complex d = csqrt(a1 * a1 - 4.0 * a2);
+    double complex z[2] = { (-a1 + d) / 2.0, (-a1 - d) / 2.0 };
+    p->max_radius = 0.0;
+    for (int i = 0; i < 2; i++) {
+        p->re[i] = creal(z[i]);
+        p->im[i] = cimag(z[i]);
+        if (cabs(z[i]) > p->max_radius) p->max_radius = cabs(z[i]);
+    }
+    // s = ln(z) * fs_loop for the pole with im >= 0
+    double complex s = clog(cimag(z[0]) >= 0.0 ? z[0] : z[1]) * m->fs_loop;
+    double wn = cabs(s);
+    p->fn_hz = wn / (2.0 * M_PI);
+    p->zeta  = (wn > 0.0) ? -creal(s) / wn : NAN;
+}
+
+// log-spaced scan + bisection on a sign change of fn
+static double find_crossing(const pll_q30_model_t *m, double (*fn)(const pll_q30_model_t *, double))
+{
+    const int N = 2000;
+    double f0 = m->fs_loop * 1e-7, f1 = m->fs_loop * 0.4999;
+    double prev_f = f0, prev_v = fn(m, f0);
+    for (int i = 1; i <= N; i++) {
+        double f = f0 * pow(f1 / f0, (double)i / N), v = fn(m, f);
+        if ((prev_v > 0.0) != (v > 0.0)) {
+            double lo = prev_f, hi = f;
+            for (int it = 0; it < 60; it++) {
+                double mid = sqrt(lo * hi);
+                if ((fn(m, mid) > 0.0) == (prev_v > 0.0)) lo = mid; else hi = mid;
+            }
+            return sqrt(lo * hi);
+        }
+        prev_f = f;
+        prev_v = v;
+    }
+    return NAN;
+}
+
+static double ol_mag_minus_1(const pll_q30_model_t *m, double f)
+{
+    double mag = 0.0;
+    pll_q30_model_resp(m, PLL_MODEL_OL, f, &mag, NULL);
+    return mag - 1.0;
+}
+
+// Type-2 loop: the OL phase starts just above -180 deg (Im L < 0) and falls
+// through -180 where Im L changes sign with Re L < 0.
+static double ol_imag(const pll_q30_model_t *m, double f)
+{
+    return cimag(eval(&m->tf[PLL_MODEL_OL], 2.0 * M_PI * f / m->fs_loop));
+}
+
+static double cl_mag_minus_3db(const pll_q30_model_t *m, double f)
+{
+    double mag = 0.0;
+    pll_q30_model_resp(m, PLL_MODEL_CL, f, &mag, NULL);
+    return 20.0 * log10(mag) + 3.0;
+}
+
+void pll_q30_model_margins(const pll_q30_model_t *m, pll_model_margins_t *mg)
+{
+    if (!m || !mg) return;
+    double mag = 0.0, ph = 0.0;
+
+    mg->fc_hz = find_crossing(m, ol_mag_minus_1);
+    if (isnan(mg->fc_hz)) {
+        mg->pm_deg = NAN;
+    } else {
+        pll_q30_model_resp(m, PLL_MODEL_OL, mg->fc_hz, NULL, &ph);
+        mg->pm_deg = 180.0 + ph;
+    }
+
+    // phase crossover
+    mg->f180_hz = NAN;
+    mg->gm_db = NAN;
+    {
+        double f = find_crossing(m, ol_imag);
+        if (!isnan(f)) {
+            double complex h = eval(&m->tf[PLL_MODEL_OL], 2.0 * M_PI * f / m->fs_loop);
+            if (creal(h) < 0.0) {
+                mg->f180_hz = f;
+                mg->gm_db = -20.0 * log10(cabs(h));
+            }
+        }
+    }
+
+    mg->peak_db = -1e9;
+    mg->peak_hz = 0.0;
+    for (int i = 0; i <= 4000; i++) {
+        double f = m->fs_loop * 1e-7 * pow(0.4999 / 1e-7, i / 4000.0);
+        pll_q30_model_resp(m, PLL_MODEL_CL, f, &mag, NULL);
+        if (20.0 * log10(mag) > mg->peak_db) { mg->peak_db = 20.0 * log10(mag); mg->peak_hz = f; }
+    }
+    mg->bw3_hz = find_crossing(m, cl_mag_minus_3db);
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Linearised discrete-time model of the pll_q30 loop.
+//
+// Built from the same constants as the code: the Q2.30 gains, PLL_INV_FS_Q32
+// (for the loop rate), the Q-format shifts in pll_config.h and the input
+// amplitude. Around lock (input 1/4 turn ahead of theta) the placeholder
+// phase detector -x*sin(theta) averages to Kd * (phi - theta) with
+// Kd = pi * A (Q30 units per turn); the 2f term is ignored. Per loop sample:
+//   qerr_k  = Kd (phi_k - theta_k)
+//   f_k     = Ku (kp qerr_k + I_k),  I_k = I_{k-1} + ki qerr_k     [Hz]
+//   theta_{k+1} = theta_k + Kv f_k                                  [turns]
+// with Ku = 2^(5 - PLL_DF_SHIFT) Hz per Q30 unit and
+// Kv = INV_FS * 2^(25 - PLL_INC_SHIFT - 30) turns per Hz.
+//
+// Transfer functions are b(z^-1) / a(z^-1), coefficients in ascending
+// powers of z^-1 (scipy.signal / MATLAB "b, a" order), sample time 1/fs_loop:
+//   ol : phase error    -> output phase   L(z)
+//   ef : phase error    -> out_f [Hz/turn] Kd Ku C(z)
+//   cl : input phase    -> output phase   L / (1 + L)
+//   err: input phase    -> phase error    1 / (1 + L)
+//   ff : input freq     -> out_f          cl / (Kv fs_loop)
+// Decimation: the loop steps at fs / decim, with INV_FS for that rate.
+
+#define PLL_MODEL_NCOEF 3
+
+typedef enum { PLL_MODEL_OL, PLL_MODEL_EF, PLL_MODEL_CL, PLL_MODEL_ERR, PLL_MODEL_FF, PLL_MODEL_N } pll_model_tf_t;
+
+typedef struct {
+    double b[PLL_MODEL_NCOEF];
+    double a[PLL_MODEL_NCOEF];
+} pll_model_coef_t;
+
+typedef struct {
+    // inputs
+    double   kp, ki;           // real gains
+    double   amp;              // input amplitude, full scale = 1.0
+    double   fs, fs_loop;      // input and loop sample rates [Hz]
+    int      decim;
+    uint32_t inv_fs_q32;       // reciprocal the loop uses
+    // derived
+    double   kd, ku, kv, g;    // g = Kd Ku Kv
+    pll_model_coef_t tf[PLL_MODEL_N];
+} pll_q30_model_t;
+
+extern const char *const pll_model_tf_name[PLL_MODEL_N];
+
+// Returns 0, or -1 on invalid parameters.
+int  pll_q30_model_build(pll_q30_model_t *m, int32_t kp_q30, int32_t ki_q30,
+                         double amp, double fs_hz, int decim);
+
+// Frequency response of one transfer function at f_hz (loop rate).
+void pll_q30_model_resp(const pll_q30_model_t *m, pll_model_tf_t tf, double f_hz,
+                        double *mag, double *phase_deg);
+
+// Closed-loop poles (z-plane) and their continuous equivalents.
+typedef struct {
+    double re[2], im[2];       // z-plane poles
+    double max_radius;         // < 1: stable
+    double fn_hz, zeta;        // natural frequency / damping of the pole pair
+} pll_model_poles_t;
+
+void pll_q30_model_poles(const pll_q30_model_t *m, pll_model_poles_t *p);
+
+// Open-loop margins. Fields are NAN when the crossing does not exist.
+typedef struct {
+    double fc_hz, pm_deg;      // gain crossover, phase margin
+    double f180_hz, gm_db;     // phase crossover, gain margin
+    double peak_db, peak_hz;   // closed-loop peaking
+    double bw3_hz;             // closed-loop -3 dB bandwidth
+} pll_model_margins_t;
+
+void pll_q30_model_margins(const pll_q30_model_t *m, pll_model_margins_t *mg);
+
+#ifdef __cplusplus
+}
+#endif
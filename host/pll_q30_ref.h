@@ -0,0 +1,43 @@
+#pragma once
+#include <stdint.h>
+
+#include "pll_q30.h"
+#include "pll_fixed.h"
+#include "sine_q230_1024.h"
+
+// Reference pll_q30 step for the host tools: the loop exactly as in the
+// original pll_q30.c, written with the *_ref helpers and no build options
+// (full 1024 table, cos and delta always stored). Optimized builds of
+// pll_q30_step are differential-checked against this.
+// Only the defined-behaviour fixes are applied: Q22->Q30 shifts as unsigned
+// and the phase-detector negate wraps (-INT32_MIN == INT32_MIN, as compiled).
+// Returns nonzero if one of the PI clamps engaged on this sample, i.e. the
+// HDL itself saturated: PLL_REF_SAT_PROD for the kp/ki products,
+// PLL_REF_SAT_SUM for the integrator or the PI sum (or both bits).
+#define PLL_REF_SAT_PROD  1
+#define PLL_REF_SAT_SUM   2
+
+static inline int pll_q30_ref_step(pll_q30_state_t *st, int32_t x_q22)
+{
+    const uint32_t INV_FS_Q32 = (uint32_t)((((uint64_t)1u << 32) + (40000 / 2)) / 40000u);
+    uint32_t idx = (st->theta_q30 >> 20) & 1023;
+    st->sin_q30 = sine_q230[idx];
+    st->cos_q30 = sine_q230[(idx + 256) & 1023];
+    int32_t x_q30 = (int32_t)((uint32_t)x_q22 << 8);
+    int32_t qerr_q30 = (int32_t)(0u - (uint32_t)pll_mul_q30_ref(x_q30, st->sin_q30));
+    int64_t p_raw = ((int64_t)st->kp_q30 * qerr_q30) >> 30;
+    int64_t i_raw = ((int64_t)st->ki_q30 * qerr_q30) >> 30;
+    int32_t p_q30 = pll_mul_q30_ref(st->kp_q30, qerr_q30);
+    int64_t integ = (int64_t)st->integrator_q30 + pll_mul_q30_ref(st->ki_q30, qerr_q30);
+    st->integrator_q30 = pll_sat32_ref(integ);
+    int64_t u_raw = (int64_t)p_q30 + st->integrator_q30;
+    int32_t u_q30 = pll_sat32_ref(u_raw);
+    int sat = (p_raw != p_q30 || i_raw != pll_mul_q30_ref(st->ki_q30, qerr_q30) ? PLL_REF_SAT_PROD : 0) |
+              (integ != st->integrator_q30 || u_raw != u_q30 ? PLL_REF_SAT_SUM : 0);
+    st->delta_f_q25 = pll_sat32_ref((int64_t)u_q30 >> 5);
+    int32_t f_q25 = (int32_t)(50 << 25) + st->delta_f_q25;
+    st->out_f_q25 = f_q25;
+    int64_t prod = (int64_t)f_q25 * (int64_t)INV_FS_Q32;
+    st->theta_q30 = (st->theta_q30 + (uint32_t)(int32_t)(prod >> 27)) & 0x3FFFFFFF;
+    return sat;
+}
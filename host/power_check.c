@@ -0,0 +1,135 @@
+// Accuracy of the feeder-bank power stage (pll_power.h) against double.
+//
+// A three-phase grid (voltage amplitude 0.9 pu, frequency -f) feeds
+// PLL_PWR_N feeders with different current amplitudes and power-factor
+// angles; the last feeder has phase c at half current (unbalanced, so p and
+// q carry a 2f ripple). The loop tracks phase a of the voltage; its sin/cos
+// and theta drive the bank, PLL_PWR_AVG | PLL_PWR_DQ.
+//
+// Reported per feeder:
+//   inst : max |p - p_double|, |q - q_double| per sample (same Q22 inputs)
+//   dq   : max |3/2 (vd id + vq iq) - p| from the dq outputs (frame check)
+//   avg  : max |p_avg - mean of p_double over the same samples|
+//   ideal: last p_avg/q_avg against 3/2 V I cos/sin(phi) (balanced feeders)
+//
+// Build: cc -O2 -I.. -o power_check power_check.c ../pll_power.c ../pll_q30.c -lm
+// Run  : ./power_check [-f f_hz] [-s seconds]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "pll_config.h"
+#include "pll_q30.h"
+#include "pll_power.h"
+
+#if !PLL_OUT_COS
+#error "pll_pwr_step_st needs PLL_OUT_COS=1 (the default)"
+#endif
+
+#define KP_Q30     0x20000000
+#define KI_Q30     0x00147AE1
+#define VAMP       0.9
+#define Q22        4194304.0
+#define Q30        1073741824.0
+
+int main(int argc, char **argv)
+{
+    double f = 50.0;
+    int    seconds = 3;
+
+    for (int i = 1; i < argc; i++) {
+        if      (!strcmp(argv[i], "-f") && i + 1 < argc) f = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) seconds = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [-f f_hz] [-s seconds]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (seconds < 2) seconds = 2;
+
+    double iamp[PLL_PWR_N], phi[PLL_PWR_N];
+    for (int k = 0; k < PLL_PWR_N; k++) {
+        iamp[k] = 0.2 + 0.1 * k;
+        phi[k]  = (-60.0 + 20.0 * k) * M_PI / 180.0;
+    }
+
+    pll_q30_state_t st;
+    pll_pwr_bank_t  bank;
+    pll_q30_init(&st, KP_Q30, KI_Q30);
+    pll_pwr_init(&bank, PLL_PWR_AVG | PLL_PWR_DQ);
+
+    static int32_t v[3][PLL_PWR_N], cur[3][PLL_PWR_N];
+    double e_inst[PLL_PWR_N] = {0}, e_dq[PLL_PWR_N] = {0}, e_avg[PLL_PWR_N] = {0};
+    double pd_sum[PLL_PWR_N] = {0}, qd_sum[PLL_PWR_N] = {0};
+    const long n = (long)seconds * PLL_FS_HZ, settle = PLL_FS_HZ;
+    double   ph = 0.0;
+    long     cnt = 0, checked = 0;
+    int      started = 0;
+    uint32_t theta_prev = 0;
+
+    for (long s = 0; s < n; s++) {
+        for (int p = 0; p < 3; p++) {
+            double w = 2.0 * M_PI * (ph - p / 3.0);
+            for (int k = 0; k < PLL_PWR_N; k++) {
+                double ia = iamp[k] * ((k == PLL_PWR_N - 1 && p == 2) ? 0.5 : 1.0);
+                v[p][k]   = (int32_t)lrint(VAMP * sin(w) * Q22);
+                cur[p][k] = (int32_t)lrint(ia * sin(w - phi[k]) * Q22);
+            }
+        }
+        ph += f / PLL_FS_HZ;
+        ph -= floor(ph);
+
+        pll_q30_step(&st, v[0][0]);
+        int done = pll_pwr_step_st(&bank, &st, v, cur);
+
+        // same windows as the bank: from one theta wrap to the sample before the next
+        int wrap = st.theta_q30 < theta_prev;
+        theta_prev = st.theta_q30;
+        if (wrap) {
+            if (done != (started && cnt > 0)) { printf("cycle boundary mismatch at sample %ld\n", s); return 1; }
+            for (int k = 0; done && s >= settle && k < PLL_PWR_N; k++) {
+                e_avg[k] = fmax(e_avg[k], fabs(bank.p_avg_q30[k] / Q30 - pd_sum[k] / cnt));
+                e_avg[k] = fmax(e_avg[k], fabs(bank.q_avg_q30[k] / Q30 - qd_sum[k] / cnt));
+            }
+            checked += done && s >= settle;
+            for (int k = 0; k < PLL_PWR_N; k++) pd_sum[k] = qd_sum[k] = 0.0;
+            cnt = 0;
+            started = 1;
+        }
+
+        for (int k = 0; k < PLL_PWR_N; k++) {
+            // double reference on the same quantized inputs
+            double va = v[0][k] / Q22, vb = v[1][k] / Q22, vc = v[2][k] / Q22;
+            double ia = cur[0][k] / Q22, ib = cur[1][k] / Q22, ic = cur[2][k] / Q22;
+            double val = (2 * va - vb - vc) / 3, vbe = (vb - vc) / sqrt(3.0);
+            double ial = (2 * ia - ib - ic) / 3, ibe = (ib - ic) / sqrt(3.0);
+            double pd = 1.5 * (val * ial + vbe * ibe), qd = 1.5 * (vbe * ial - val * ibe);
+            double pdq = 1.5 * ((double)bank.vd_q22[k] * bank.id_q22[k] +
+                                (double)bank.vq_q22[k] * bank.iq_q22[k]) / (Q22 * Q22);
+            pd_sum[k] += pd;
+            qd_sum[k] += qd;
+            e_inst[k] = fmax(e_inst[k], fmax(fabs(bank.p_q30[k] / Q30 - pd), fabs(bank.q_q30[k] / Q30 - qd)));
+            e_dq[k]   = fmax(e_dq[k], fabs(pdq - bank.p_q30[k] / Q30));
+        }
+        cnt++;
+    }
+
+    printf("%d feeders, %.2f Hz, Fs %d Hz, %d s; %u cycles averaged, %ld checked after %ld s\n",
+           PLL_PWR_N, f, PLL_FS_HZ, seconds, bank.cycles, checked, settle / PLL_FS_HZ);
+    printf("%3s %6s %6s %11s %11s %11s %10s %10s %10s %10s\n", "k", "I pu", "phi", "inst", "dq", "avg",
+           "p_avg", "p ideal", "q_avg", "q ideal");
+    for (int k = 0; k < PLL_PWR_N; k++) {
+        char pi[16] = "-", qi[16] = "-";
+        if (k != PLL_PWR_N - 1) {           // balanced: constant 3/2 V I cos/sin(phi)
+            snprintf(pi, sizeof pi, "%.6f", 1.5 * VAMP * iamp[k] * cos(phi[k]));
+            snprintf(qi, sizeof qi, "%.6f", 1.5 * VAMP * iamp[k] * sin(phi[k]));
+        }
+        printf("%3d %6.2f %6.1f %11.3e %11.3e %11.3e %10.6f %10s %10.6f %10s\n", k, iamp[k],
+               phi[k] * 180.0 / M_PI, e_inst[k], e_dq[k], e_avg[k], bank.p_avg_q30[k] / Q30, pi,
+               bank.q_avg_q30[k] / Q30, qi);
+    }
+    return 0;
+}
@@ -0,0 +1,233 @@
+// Dynamic range of the pll_q30_step intermediates over capture files.
+//
+// Runs pll_q30 (built with -DPLL_RANGE_INSTRUMENT=1) over every capture, one
+// fresh PLL per file, files spread over worker threads. Prints per file the
+// sample and saturation counts, then per intermediate over all files: min,
+// max, saturation count, signed bits used, headroom in the 32-bit format and
+// how many LSBs a 16-bit format would have to drop.
+//
+// Capture formats (by extension):
+//   .txt / .csv : one sample per line, first field; with a '.' it is a value
+//                 in full-scale units (+-1.0), otherwise an integer Q22
+//   anything else: raw little-endian int32 Q22 (HDL Input_sine)
+// Without files, a built-in set of synthetic scenarios is scanned instead.
+//
+// Build: cc -O2 -pthread -DPLL_RANGE_INSTRUMENT=1 -I.. -o range_scan range_scan.c
+//           ../pll_q30.c ../pll_range.c -lm
+// Run  : ./range_scan [-j threads] [-k kp_q30 ki_q30] [capture ...]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "pll_q30.h"
+#include "pll_range.h"
+#include "pll_config.h"
+
+#if !PLL_RANGE_INSTRUMENT
+#error "build with -DPLL_RANGE_INSTRUMENT=1 (library and tool)"
+#endif
+
+#define KP_Q30     0x20000000
+#define KI_Q30     0x00147AE1
+#define MAX_FILES  4096
+
+typedef struct {
+    const char *name;          // file path, or scenario name
+    int         synth;         // >= 0: built-in scenario index
+    pll_range_t r;
+    int         err;
+} job_t;
+
+static job_t   *jobs;
+static int      njobs;
+static int      next_job;
+static int32_t  kp = KP_Q30, ki = KI_Q30;
+
+// ---------- capture loading ----------
+static int has_ext(const char *p, const char *ext)
+{
+    size_t n = strlen(p), e = strlen(ext);
+    return n > e && strcmp(p + n - e, ext) == 0;
+}
+
+static int32_t *load_text(FILE *f, size_t *n)
+{
+    size_t cap = 1 << 16, k = 0;
+    int32_t *x = malloc(cap * sizeof *x);
+    char line[256];
+    while (x && fgets(line, sizeof line, f)) {
+        char *end;
+        double v = strtod(line, &end);
+        if (end == line) continue;                    // header / blank
+        if (memchr(line, '.', (size_t)(end - line))) v *= (double)(1 << 22);
+        if (k == cap) {
+            int32_t *nx = realloc(x, (cap *= 2) * sizeof *x);
+            if (!nx) { free(x); return NULL; }
+            x = nx;
+        }
+        if (v >  2147483647.0) v =  2147483647.0;
+        if (v < -2147483648.0) v = -2147483648.0;
+        x[k++] = (int32_t)lrint(v);
+    }
+    *n = k;
+    return x;
+}
+
+static int32_t *load_raw(FILE *f, size_t *n)
+{
+    if (fseek(f, 0, SEEK_END) != 0) return NULL;
+    long bytes = ftell(f);
+    rewind(f);
+    if (bytes < 4) return NULL;
+    size_t k = (size_t)bytes / 4;
+    uint8_t *b = malloc(k * 4);
+    int32_t *x = malloc(k * sizeof *x);
+    if (!b || !x || fread(b, 4, k, f) != k) { free(b); free(x); return NULL; }
+    for (size_t i = 0; i < k; i++)
+        x[i] = (int32_t)((uint32_t)b[4*i] | ((uint32_t)b[4*i+1] << 8) |
+                         ((uint32_t)b[4*i+2] << 16) | ((uint32_t)b[4*i+3] << 24));
+    free(b);
+    *n = k;
+    return x;
+}
+
+// ---------- synthetic scenarios (no captures given) ----------
+static const char *const synth_name[] = {
+    "nominal 50 Hz 0.9 FS",
+    "step 50 -> 52 Hz",
+    "step 50 -> 47 Hz",
+    "full scale + 5th/7th harmonics",
+    "clipped 1.3 FS",
+    "phase jump 90 deg",
+};
+#define N_SYNTH ((int)(sizeof synth_name / sizeof synth_name[0]))
+
+static int32_t *make_synth(int s, size_t *n)
+{
+    const size_t len = 4 * PLL_FS_HZ;                 // 4 s
+    int32_t *x = malloc(len * sizeof *x);
+    if (!x) return NULL;
+    double ph = 0.0;
+    for (size_t i = 0; i < len; i++) {
+        int late = i >= len / 4;
+        double f = 50.0, a = 0.9, v;
+        if (s == 1 && late) f = 52.0;
+        if (s == 2 && late) f = 47.0;
+        if (s == 5 && i == len / 4) ph += 0.25;
+        v = a * sin(2.0 * M_PI * ph);
+        if (s == 3) v = sin(2.0 * M_PI * ph) + 0.2 * sin(10.0 * M_PI * ph) + 0.14 * sin(14.0 * M_PI * ph);
+        if (s == 4) { v = 1.3 * sin(2.0 * M_PI * ph); if (v > 1.0) v = 1.0; if (v < -1.0) v = -1.0; }
+        x[i] = (int32_t)lrint(v * (1 << 22));
+        ph += f / PLL_FS_HZ;
+        ph -= floor(ph);
+    }
+    *n = len;
+    return x;
+}
+
+// ---------- workers ----------
+static void run_job(job_t *j)
+{
+    size_t n = 0;
+    int32_t *x = NULL;
+
+    if (j->synth >= 0) {
+        x = make_synth(j->synth, &n);
+    } else {
+        int text = has_ext(j->name, ".txt") || has_ext(j->name, ".csv");
+        FILE *f = fopen(j->name, text ? "r" : "rb");
+        if (f) {
+            x = text ? load_text(f, &n) : load_raw(f, &n);
+            fclose(f);
+        }
+    }
+    pll_range_reset(&j->r);
+    if (!x) { j->err = 1; return; }
+
+    pll_q30_state_t st;
+    pll_q30_init(&st, kp, ki);
+    pll_range_bind(&j->r);
+    for (size_t i = 0; i < n; i++) pll_q30_step(&st, x[i]);
+    pll_range_bind(NULL);
+    free(x);
+}
+
+static void *worker(void *arg)
+{
+    (void)arg;
+    for (;;) {
+        int i = __atomic_fetch_add(&next_job, 1, __ATOMIC_RELAXED);
+        if (i >= njobs) return NULL;
+        run_job(&jobs[i]);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    long nthreads = sysconf(_SC_NPROCESSORS_ONLN);
+    int  argi = 1;
+
+    for (; argi < argc && argv[argi][0] == '-'; argi++) {
+        if (!strcmp(argv[argi], "-j") && argi + 1 < argc) {
+            nthreads = atol(argv[++argi]);
+        } else if (!strcmp(argv[argi], "-k") && argi + 2 < argc) {
+            kp = (int32_t)strtol(argv[argi + 1], NULL, 0);
+            ki = (int32_t)strtol(argv[argi + 2], NULL, 0);
+            argi += 2;
+        } else {
+            fprintf(stderr, "usage: %s [-j threads] [-k kp_q30 ki_q30] [capture ...]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (nthreads < 1) nthreads = 1;
+
+    int nfiles = argc - argi;
+    if (nfiles > MAX_FILES) nfiles = MAX_FILES;
+    njobs = nfiles ? nfiles : N_SYNTH;
+    jobs = calloc((size_t)njobs, sizeof *jobs);
+    if (!jobs) return 1;
+    for (int i = 0; i < njobs; i++) {
+        jobs[i].name  = nfiles ? argv[argi + i] : synth_name[i];
+        jobs[i].synth = nfiles ? -1 : i;
+    }
+
+    if (nthreads > njobs) nthreads = njobs;
+    pthread_t th[64];
+    if (nthreads > 64) nthreads = 64;
+    for (long t = 0; t < nthreads; t++) pthread_create(&th[t], NULL, worker, NULL);
+    for (long t = 0; t < nthreads; t++) pthread_join(th[t], NULL);
+
+    printf("kp_q30 0x%08X  ki_q30 0x%08X  %d %s, %ld threads\n",
+           (unsigned)kp, (unsigned)ki, njobs, nfiles ? "captures" : "synthetic scenarios", nthreads);
+
+    pll_range_t all;
+    pll_range_reset(&all);
+    int errs = 0;
+    for (int i = 0; i < njobs; i++) {
+        if (jobs[i].err) { printf("  %-36s  unreadable\n", jobs[i].name); errs++; continue; }
+        uint64_t sat = 0;
+        for (int v = 0; v < PLL_RANGE_N; v++) sat += jobs[i].r.sat[v];
+        printf("  %-36s %10llu samples %8llu saturations\n", jobs[i].name,
+               (unsigned long long)jobs[i].r.samples, (unsigned long long)sat);
+        pll_range_merge(&all, &jobs[i].r);
+    }
+    if (!all.samples) return 1;
+
+    printf("\n%-15s %14s %14s %10s %5s %9s %12s\n",
+           "intermediate", "min", "max", "sat", "bits", "headroom", "16-bit: >>");
+    for (int v = 0; v < PLL_RANGE_N; v++) {
+        int bits = pll_range_bits(&all, v);
+        printf("%-15s %14lld %14lld %10llu %5d %8d  %12d\n", pll_range_name[v],
+               (long long)all.min[v], (long long)all.max[v], (unsigned long long)all.sat[v],
+               bits, 32 - bits, bits > 16 ? bits - 16 : 0);
+    }
+    printf("\nheadroom: spare bits in the 32-bit format (< 0: saturated/wrapped)\n"
+           "16-bit: >> LSBs to drop so the observed range fits an int16\n");
+    free(jobs);
+    return errs ? 1 : 0;
+}
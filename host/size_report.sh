@@ -0,0 +1,53 @@
+#!/bin/sh
+# Code/data size per PLL object, per symbol and per build configuration.
+#
+# Usage: CROSS_COMPILE=riscv64-unknown-elf- ./size_report.sh [-DFLAG ...]
+#   Builds the "full" and "minimal" (-DPLL_PROFILE_MINIMAL) configurations,
+#   plus any extra flags given (e.g. -DPLL_USE_TCM), and prints section sizes
+#   per object, the size of each pll_*/sine_* symbol, and whether the objects
+#   pull in 64-bit division or printf helpers.
+#
+# Env: CROSS_COMPILE (default: host tools), CFLAGS (default: -Os),
+#      ARCH_FLAGS (e.g. "-march=rv32imc -mabi=ilp32")
+
+set -e
+CC="${CROSS_COMPILE}gcc"
+SIZE="${CROSS_COMPILE}size"
+NM="${CROSS_COMPILE}nm"
+CFLAGS="${CFLAGS:--Os}"
+SRC_DIR="$(cd "$(dirname "$0")/.." && pwd)"
+OUT="$(mktemp -d)"
+trap 'rm -rf "$OUT"' EXIT
+
+report() {
+    cfg="$1"; shift
+    objs="$1"; shift
+    mkdir -p "$OUT/$cfg"
+    echo "==== $cfg: $CFLAGS $ARCH_FLAGS $* ===="
+
+    for o in $objs; do
+        $CC $CFLAGS $ARCH_FLAGS "$@" -c "$SRC_DIR/$o.c" -I"$SRC_DIR" -o "$OUT/$cfg/$o.o"
+    done
+
+    echo "-- per object (bytes) --"
+    ( cd "$OUT/$cfg" && $SIZE -A $(for o in $objs; do printf '%s.o ' "$o"; done) ) |
+        awk '/^[a-z_0-9]+\.o/ { obj=$1 }
+             /^\.(text|rodata|srodata|data|sdata|bss|sbss|tcm_text|tcm_rodata)/ && $2 > 0 {
+                 printf "%-18s %-14s %8d\n", obj, $1, $2; tot += $2 }
+             END { printf "%-18s %-14s %8d\n", "total", "", tot }'
+
+    echo "-- per symbol (bytes) --"
+    for o in $objs; do
+        $NM --size-sort -S -t d "$OUT/$cfg/$o.o" |
+            awk -v obj="$o.o" '$4 ~ /^(pll_|sine_)/ { printf "%-18s %-32s %8d  %s\n", obj, $4, $2, $3 }'
+    done
+
+    echo "-- runtime helpers referenced --"
+    helpers=$(for o in $objs; do $NM -u "$OUT/$cfg/$o.o"; done |
+              awk '$2 ~ /^(__(u)?(div|mod)di3|printf|xil_printf|puts)$/ { print $2 }' | sort -u)
+    echo "${helpers:-none}"
+    echo
+}
+
+report full    "pll_q30 pll_q30w pll_q15 pll_f32 pll_mailbox pll_bram_out pll_pps pll_ref pll_ipark pll_power pll_resamp pll_sdft pll_biquad" "$@"
+report minimal "pll_q30" -DPLL_PROFILE_MINIMAL "$@"
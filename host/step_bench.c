@@ -0,0 +1,80 @@
+// Host cycles/sample of the PLL step for the current build configuration.
+//
+// Build the same driver once per profile/engine and compare, e.g.
+//   cc -O2 -I..                       -o bench_full step_bench.c pll_frontend.c ../pll_q30.c -lm
+//   cc -Os -I.. -DPLL_PROFILE_MINIMAL -o bench_min  step_bench.c pll_frontend.c ../pll_q30.c -lm
+//   cc -O2 -I.. -DPLL_ENGINE=PLL_ENGINE_F32 -o bench_f32 step_bench.c pll_frontend.c ../pll_f32.c -lm
+//   cc -O2 -I.. -DPLL_ENGINE=PLL_ENGINE_Q15 -o bench_q15 step_bench.c pll_frontend.c ../pll_q15.c -lm
+//   cc -O2 -I.. -DPLL_ENGINE=PLL_ENGINE_Q30W -o bench_q30w step_bench.c pll_frontend.c ../pll_q30w.c -lm
+// Run  : ./bench_full [board|front-end spec]
+// The stimulus is the ideal table sine (as on the board's BRAM input); with
+// an argument it goes through the ADC front-end model (pll_frontend.h)
+// instead, so data-dependent costs (saturation, branches) see real samples.
+// x86 uses the TSC (reference cycles); other hosts fall back to ns.
+// The board figure comes from helloworld.c, which prints the profile name.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "pll_config.h"
+#include "pll_engine.h"
+#include "sine_q230_1024.h"
+#include "pll_frontend.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint64_t ticks(void) { return __rdtsc(); }
+#define TICK_UNIT "cyc"
+#else
+static inline uint64_t ticks(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+#define TICK_UNIT "ns"
+#endif
+
+#define N_SAMPLES  800     // one 50 Hz cycle, so the repeated block is continuous
+#define N_REPEAT   2000
+
+int main(int argc, char **argv)
+{
+    static int32_t x[N_SAMPLES];
+    const char *fe_desc = "ideal table";
+    if (argc > 1) {
+        pll_fe_t fe;
+        uint64_t rng = 0x5EED;
+        if (pll_fe_parse(&fe, argv[1]) != 0) {
+            fprintf(stderr, "usage: %s [board|front-end spec]\n", argv[0]);
+            return 2;
+        }
+        pll_fe_sine(&fe, &rng, 0.9, 50.0, PLL_FS_HZ, 0.0, x, N_SAMPLES);
+        fe_desc = argv[1];
+    } else {
+        const uint32_t phase_step = (uint32_t)(((uint64_t)50u << 32) / (uint64_t)PLL_FS_HZ);
+        uint32_t phase = 0;
+        for (int i = 0; i < N_SAMPLES; i++) {
+            x[i] = sine_q230[phase >> 22] >> 8;
+            phase += phase_step;
+        }
+    }
+
+    pll_engine_state_t st;
+    pll_engine_init(&st, 0x20000000, 0x00147AE1);
+    for (int i = 0; i < 20000; i++) pll_engine_step(&st, x[i % N_SAMPLES]);
+
+    uint64_t best = UINT64_MAX;
+    for (int r = 0; r < N_REPEAT; r++) {
+        uint64_t t0 = ticks();
+        for (int i = 0; i < N_SAMPLES; i++) pll_engine_step(&st, x[i]);
+        uint64_t t1 = ticks();
+        if (t1 - t0 < best) best = t1 - t0;
+    }
+
+    printf("profile=%s engine=%s input=%s  %.2f %s/sample (best of %d x %d)  out_f=0x%08lx\n",
+           PLL_PROFILE_NAME, PLL_ENGINE_NAME, fe_desc, (double)best / N_SAMPLES, TICK_UNIT, N_REPEAT, N_SAMPLES,
+           (unsigned long)(uint32_t)pll_engine_out_f_q25(&st));
+    return 0;
+}
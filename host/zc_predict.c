@@ -0,0 +1,113 @@
+// Zero-crossing prediction with pll_phase.h (pll_zc_*), against the exact
+// crossings of the input.
+//
+// Every sample the loop steps, pll_zc_update() refreshes the reciprocal and
+// the time to the next positive-going zero crossing of the input is
+// predicted (target PLL_ZC_POS_Q30: theta = 3/4 turn, the loop locking a
+// quarter turn behind the input). Reported:
+//   arith : prediction vs the same formula in double (dphi / inc); this is
+//           the predictor's own error, the Newton reciprocal included
+//   input : predicted vs true next crossing of the input sine, every sample
+//           of the settled window (second half of the run), modulo a period;
+//           the loop's phase error and its 2f ripple dominate, not the
+//           arithmetic
+//   sample: lateness of "first sample after the crossing" detection, the
+//           baseline without a predictor (0..1 sample)
+// -d adds a frequency step at 1 s to exercise reseeding and tracking.
+//
+// Build: cc -O2 -I.. -o zc_predict zc_predict.c ../pll_q30.c -lm
+// Run  : ./zc_predict [-f f0_hz] [-d df_hz] [-s seconds]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "pll_config.h"
+#include "pll_q30.h"
+#include "pll_phase.h"
+
+#define KP_Q30     0x20000000
+#define KI_Q30     0x00147AE1
+#define AMP        0.9
+
+typedef struct { double s, s2, mx; long n; } acc_t;
+
+static void acc_add(acc_t *a, double v)
+{
+    a->s += v;
+    a->s2 += v * v;
+    if (fabs(v) > a->mx) a->mx = fabs(v);
+    a->n++;
+}
+
+static void acc_print(const char *name, const acc_t *a, double scale, const char *unit)
+{
+    double n = a->n ? (double)a->n : 1.0;
+    printf("  %-7s mean %+10.4f  rms %9.4f  max %9.4f %s  (%ld points)\n", name,
+           scale * a->s / n, scale * sqrt(a->s2 / n), scale * a->mx, unit, a->n);
+}
+
+int main(int argc, char **argv)
+{
+    double f0 = 50.2, df = 0.0;
+    int    seconds = 4;
+
+    for (int i = 1; i < argc; i++) {
+        if      (!strcmp(argv[i], "-f") && i + 1 < argc) f0 = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-d") && i + 1 < argc) df = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) seconds = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [-f f0_hz] [-d df_hz] [-s seconds]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (seconds < 2) seconds = 2;
+
+    const double fs = PLL_FS_HZ, us = 1e6 / fs;
+    const long   n = (long)seconds * PLL_FS_HZ, settled = n / 2;
+    pll_q30_state_t st;
+    pll_zc_t z;
+    pll_q30_init(&st, KP_Q30, KI_Q30);
+    pll_zc_init(&z, &st);
+
+    acc_t arith = {0}, input = {0}, sample = {0};
+    double ph = 0.0;                      // input phase at the current sample, turns
+    long   invalid = 0;
+
+    for (long k = 0; k < n; k++) {
+        double f = (k >= PLL_FS_HZ) ? f0 + df : f0;
+        double x = AMP * sin(2.0 * M_PI * ph);
+        pll_q30_step(&st, (int32_t)lrint(x * 4194304.0));
+        double ph1 = ph + f / fs;         // input phase at sample k + 1
+        if (ph1 >= 1.0) {
+            // crossing between k and k + 1, seen at k + 1 without a predictor
+            if (k >= settled) acc_add(&sample, (ph1 - 1.0) / (f / fs));
+            ph1 -= 1.0;
+        }
+        ph = ph1;
+
+        if (pll_zc_update(&z, &st) != 0) { invalid++; continue; }
+        uint32_t t_q16 = pll_zc_time_q16(&z, st.theta_q30, PLL_ZC_POS_Q30);
+        double dphi = (double)((PLL_ZC_POS_Q30 - st.theta_q30) & 0x3FFFFFFFu);
+        acc_add(&arith, t_q16 / 65536.0 - dphi / (double)z.inc_q30);
+        if (k >= settled) {
+            // next true crossing after k + 1 (frequency constant from here);
+            // a loop a little ahead of the input predicts the one after, so
+            // the error is taken modulo a period
+            double period = fs / f, t_true = (1.0 - ph) * period;
+            double e = t_q16 / 65536.0 - t_true;
+            acc_add(&input, e - period * floor(e / period + 0.5));
+        }
+    }
+
+    printf("input %.3f Hz%s, Fs %d Hz, %d s; settled window from %.1f s\n", f0,
+           df != 0.0 ? " (frequency step at 1 s)" : "", PLL_FS_HZ, seconds, settled / fs);
+    if (df != 0.0) printf("  step to %.3f Hz\n", f0 + df);
+    acc_print("arith", &arith, us * 1e3, "ns");
+    acc_print("input", &input, us, "us");
+    acc_print("sample", &sample, us, "us");
+    if (invalid) printf("  %ld samples without a valid rate\n", invalid);
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include "pll_biquad.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+_Static_assert((PLL_BQ_CH % 4u) == 0, "PLL_BQ_CH must be a multiple of 4");
+
+static int coef_ok(const pll_bq_coef_t *c, uint32_t n)
+{
+    if (n > PLL_BQ_MAX || (n && !c)) return 0;
+    for (uint32_t k = 0; k < n; k++)
+        if (c[k].shift < 0 || c[k].shift > PLL_BQ_SHIFT_MAX) return 0;
+    return 1;
+}
+
+int pll_bq_init(pll_bq_cascade_t *f, const pll_bq_coef_t *c, uint32_t n)
+{
+    if (!f || !coef_ok(c, n)) return -1;
+    f->n = n;
+    for (uint32_t k = 0; k < n; k++) f->c[k] = c[k];
+    pll_bq_reset(f);
+    return 0;
+}
+
+void pll_bq_reset(pll_bq_cascade_t *f)
+{
+    if (!f) return;
+    for (uint32_t k = 0; k < PLL_BQ_MAX; k++) f->s1[k] = f->s2[k] = 0;
+}
+
+int pll_bq_bank_init(pll_bq_bank_t *b, const pll_bq_coef_t *c, uint32_t n)
+{
+    if (!b || !coef_ok(c, n)) return -1;
+    b->n = n;
+    for (uint32_t k = 0; k < n; k++) b->c[k] = c[k];
+    for (uint32_t k = 0; k < PLL_BQ_MAX; k++)
+        for (uint32_t ch = 0; ch < PLL_BQ_CH; ch++) b->s1[k][ch] = b->s2[k][ch] = 0;
+    return 0;
+}
+
+#if defined(__AVX2__)
+// 4 channels, one per 64-bit lane; values sign-extended to 64 bits so that
+// _mm256_mul_epi32 (low 32 bits, signed) reads them directly.
+static inline __m256i sat32x4(__m256i v)
+{
+    const __m256i hi = _mm256_set1_epi64x(INT32_MAX), lo = _mm256_set1_epi64x(INT32_MIN);
+    v = _mm256_blendv_epi8(v, hi, _mm256_cmpgt_epi64(v, hi));
+    return _mm256_blendv_epi8(v, lo, _mm256_cmpgt_epi64(lo, v));
+}
+
+// arithmetic >> 30 (AVX2 has no 64-bit arithmetic shift)
+static inline __m256i sra30x4(__m256i v)
+{
+    __m256i sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), v);
+    return _mm256_or_si256(_mm256_srli_epi64(v, 30), _mm256_slli_epi64(sign, 34));
+}
+
+static void bank_run_avx2(pll_bq_bank_t *b, const int32_t *x, int32_t *y)
+{
+    const __m256i pack = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    for (uint32_t ch = 0; ch < PLL_BQ_CH; ch += 4) {
+        __m256i v = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)&x[ch]));
+        for (uint32_t k = 0; k < b->n; k++) {
+            const pll_bq_coef_t *c = &b->c[k];
+            __m256i *s1 = (__m256i *)&b->s1[k][ch], *s2 = (__m256i *)&b->s2[k][ch];
+            __m256i acc = _mm256_add_epi64(_mm256_mul_epi32(_mm256_set1_epi64x(c->b0), v), _mm256_loadu_si256(s1));
+            __m256i yv  = sat32x4(sra30x4(acc));
+            __m256i t1  = _mm256_sub_epi64(_mm256_mul_epi32(_mm256_set1_epi64x(c->b1), v),
+                                           _mm256_mul_epi32(_mm256_set1_epi64x(c->a1), yv));
+            __m256i t2  = _mm256_sub_epi64(_mm256_mul_epi32(_mm256_set1_epi64x(c->b2), v),
+                                           _mm256_mul_epi32(_mm256_set1_epi64x(c->a2), yv));
+            _mm256_storeu_si256(s1, _mm256_add_epi64(t1, _mm256_loadu_si256(s2)));
+            _mm256_storeu_si256(s2, t2);
+            v = c->shift ? sat32x4(_mm256_slli_epi64(yv, c->shift)) : yv;
+        }
+        _mm_storeu_si128((__m128i *)&y[ch], _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(v, pack)));
+    }
+}
+#endif
+
+PLL_HOT_TEXT void pll_bq_bank_run(pll_bq_bank_t *b, const int32_t x[PLL_BQ_CH], int32_t y[PLL_BQ_CH])
+{
+    if (!b || !x || !y) return;
+#if defined(__AVX2__)
+    bank_run_avx2(b, x, y);
+#else
+    for (uint32_t ch = 0; ch < PLL_BQ_CH; ch++) {
+        int32_t v = x[ch];
+        for (uint32_t k = 0; k < b->n; k++) v = pll_bq_section(&b->c[k], &b->s1[k][ch], &b->s2[k][ch], v);
+        y[ch] = v;
+    }
+#endif
+}
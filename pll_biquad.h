@@ -0,0 +1,136 @@
+#pragma once
+#include <stdint.h>
+
+#include "pll_config.h"
+#include "pll_sections.h"
+#include "pll_fixed.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Q30 biquad cascade, direct form II transposed with 64-bit state:
+//   acc = b0 x + s1                y = sat32(acc >> 30)
+//   s1  = b1 x - a1 y + s2         s2 = b2 x - a2 y
+//   out = sat32(y << shift)        (next section's x)
+// Coefficients are Q2.30 (|c| < 2, a0 = 1). A section whose numerator does
+// not fit (lead-lag with a high-frequency gain of 2 or more) stores b / 2^shift
+// and the output is scaled back: the recursion runs on the scaled filter, so
+// only its rounding is amplified. The products are 32x32->64 and the state
+// keeps all 30 fraction bits; only y is rounded (toward -inf). The state
+// sums wrap (defined, unsigned) instead of overflowing when a section is
+// driven far beyond full scale; y and out always saturate.
+//
+// In the loop: pll_q30_step_lf() (pll_q30.h) filters the phase detector
+// output with a cascade before the PI, e.g. notches at 2f (the multiplier
+// detector's ripple) and 6f, or a lead-lag / low-pass shaping the open loop.
+// pll_bq_bank_run() filters PLL_BQ_CH channels with shared coefficients;
+// on host it is 4 channels per AVX2 register, bit-exact with the scalar path.
+//
+// Designs at compile time: PLL_BQ_NOTCH / PLL_BQ_LPF (RBJ cookbook) and
+// PLL_BQ_LEADLAG (bilinear, no prewarp: exact for f << Fs) expand to constant
+// initializers for pll_bq_coef_t; cos/sin are Horner polynomials (error
+// below 1e-10 up to w = pi), so no libm and nothing at run time.
+//   static const pll_bq_coef_t lf[] = { PLL_BQ_NOTCH(100.0, 2.0), PLL_BQ_NOTCH(300.0, 2.0) };
+
+#ifndef PLL_BQ_MAX
+#define PLL_BQ_MAX      4u              // sections per cascade
+#endif
+#ifndef PLL_BQ_CH
+#define PLL_BQ_CH       8u              // bank channels, multiple of 4
+#endif
+#define PLL_BQ_SHIFT_MAX 8
+
+typedef struct {
+    int32_t b0, b1, b2, a1, a2;         // Q2.30, b scaled by 2^-shift
+    int32_t shift;                      // 0..PLL_BQ_SHIFT_MAX
+} pll_bq_coef_t;
+
+typedef struct pll_bq_cascade {
+    uint32_t      n;                    // active sections (0: pass-through)
+    pll_bq_coef_t c[PLL_BQ_MAX];
+    int64_t       s1[PLL_BQ_MAX], s2[PLL_BQ_MAX];
+} pll_bq_cascade_t;
+
+typedef struct {
+    uint32_t      n;
+    pll_bq_coef_t c[PLL_BQ_MAX];
+    int64_t       s1[PLL_BQ_MAX][PLL_BQ_CH], s2[PLL_BQ_MAX][PLL_BQ_CH];
+} pll_bq_bank_t;
+
+// ---------- compile-time design ----------
+#define PLL_BQ_PI_          3.14159265358979323846
+#define PLL_BQ_W_(f)        (2.0 * PLL_BQ_PI_ * (f) / (double)PLL_FS_HZ)
+#define PLL_BQ_COS_(w)      (1.0 - (w)*(w)/2.0 * (1.0 - (w)*(w)/12.0 * (1.0 - (w)*(w)/30.0 * (1.0 - (w)*(w)/56.0 * \
+                            (1.0 - (w)*(w)/90.0 * (1.0 - (w)*(w)/132.0 * (1.0 - (w)*(w)/182.0 * (1.0 - (w)*(w)/240.0 * \
+                            (1.0 - (w)*(w)/306.0 * (1.0 - (w)*(w)/380.0 * (1.0 - (w)*(w)/462.0)))))))))))
+#define PLL_BQ_SIN_(w)      ((w) * (1.0 - (w)*(w)/6.0 * (1.0 - (w)*(w)/20.0 * (1.0 - (w)*(w)/42.0 * (1.0 - (w)*(w)/72.0 * \
+                            (1.0 - (w)*(w)/110.0 * (1.0 - (w)*(w)/156.0 * (1.0 - (w)*(w)/210.0 * (1.0 - (w)*(w)/272.0 * \
+                            (1.0 - (w)*(w)/342.0 * (1.0 - (w)*(w)/420.0 * (1.0 - (w)*(w)/506.0))))))))))))
+#define PLL_BQ_Q30_(v)      ((int32_t)((v) * 1073741824.0 + ((v) < 0.0 ? -0.5 : 0.5)))
+#define PLL_BQ_ALPHA_(f, q) (PLL_BQ_SIN_(PLL_BQ_W_(f)) / (2.0 * (q)))
+
+// notch at f0 Hz, quality q (-3 dB width f0 / q), unity gain elsewhere
+#define PLL_BQ_NOTCH(f0, q) {                                                                   \
+    PLL_BQ_Q30_(1.0 / (1.0 + PLL_BQ_ALPHA_(f0, q))),                                            \
+    PLL_BQ_Q30_(-2.0 * PLL_BQ_COS_(PLL_BQ_W_(f0)) / (1.0 + PLL_BQ_ALPHA_(f0, q))),              \
+    PLL_BQ_Q30_(1.0 / (1.0 + PLL_BQ_ALPHA_(f0, q))),                                            \
+    PLL_BQ_Q30_(-2.0 * PLL_BQ_COS_(PLL_BQ_W_(f0)) / (1.0 + PLL_BQ_ALPHA_(f0, q))),              \
+    PLL_BQ_Q30_((1.0 - PLL_BQ_ALPHA_(f0, q)) / (1.0 + PLL_BQ_ALPHA_(f0, q))), 0 }
+
+// second-order low-pass, corner f0 Hz, quality q (0.7071: Butterworth)
+#define PLL_BQ_LPF(f0, q) {                                                                     \
+    PLL_BQ_Q30_((1.0 - PLL_BQ_COS_(PLL_BQ_W_(f0))) / 2.0 / (1.0 + PLL_BQ_ALPHA_(f0, q))),       \
+    PLL_BQ_Q30_((1.0 - PLL_BQ_COS_(PLL_BQ_W_(f0))) / (1.0 + PLL_BQ_ALPHA_(f0, q))),             \
+    PLL_BQ_Q30_((1.0 - PLL_BQ_COS_(PLL_BQ_W_(f0))) / 2.0 / (1.0 + PLL_BQ_ALPHA_(f0, q))),       \
+    PLL_BQ_Q30_(-2.0 * PLL_BQ_COS_(PLL_BQ_W_(f0)) / (1.0 + PLL_BQ_ALPHA_(f0, q))),              \
+    PLL_BQ_Q30_((1.0 - PLL_BQ_ALPHA_(f0, q)) / (1.0 + PLL_BQ_ALPHA_(f0, q))), 0 }
+
+// first-order lead-lag (1 + s/wz) / (1 + s/wp): unity DC gain, fp / fz at
+// high frequency (fp > fz: lead). The numerator is scaled by 2^-shift with
+// the smallest shift that keeps it in Q2.30 (fp / fz < 256).
+#define PLL_BQ_C_           (2.0 * (double)PLL_FS_HZ)
+#define PLL_BQ_WC_(f)       (PLL_BQ_C_ / (2.0 * PLL_BQ_PI_ * (f)))
+#define PLL_BQ_LL_B0_(fz, fp) ((1.0 + PLL_BQ_WC_(fz)) / (1.0 + PLL_BQ_WC_(fp)))
+#define PLL_BQ_LL_SH_(fz, fp) \
+    (PLL_BQ_LL_B0_(fz, fp) < 1.99 ? 0 : PLL_BQ_LL_B0_(fz, fp) < 3.98 ? 1 : PLL_BQ_LL_B0_(fz, fp) < 7.96 ? 2 : \
+     PLL_BQ_LL_B0_(fz, fp) < 15.9 ? 3 : PLL_BQ_LL_B0_(fz, fp) < 31.8 ? 4 : PLL_BQ_LL_B0_(fz, fp) < 63.6 ? 5 : \
+     PLL_BQ_LL_B0_(fz, fp) < 127.0 ? 6 : 7)
+#define PLL_BQ_LEADLAG(fz, fp) {                                                                \
+    PLL_BQ_Q30_(PLL_BQ_LL_B0_(fz, fp) / (double)(1 << PLL_BQ_LL_SH_(fz, fp))),                  \
+    PLL_BQ_Q30_((1.0 - PLL_BQ_WC_(fz)) / (1.0 + PLL_BQ_WC_(fp)) / (double)(1 << PLL_BQ_LL_SH_(fz, fp))), \
+    0,                                                                                          \
+    PLL_BQ_Q30_((1.0 - PLL_BQ_WC_(fp)) / (1.0 + PLL_BQ_WC_(fp))),                               \
+    0, PLL_BQ_LL_SH_(fz, fp) }
+
+#define PLL_BQ_PASS         { 1 << 30, 0, 0, 0, 0, 0 }
+
+// ---------- run time ----------
+// n sections from c (n <= PLL_BQ_MAX, shifts in range), state cleared; -1
+// (cascade untouched) otherwise.
+int  pll_bq_init(pll_bq_cascade_t *f, const pll_bq_coef_t *c, uint32_t n);
+void pll_bq_reset(pll_bq_cascade_t *f);
+int  pll_bq_bank_init(pll_bq_bank_t *b, const pll_bq_coef_t *c, uint32_t n);
+
+// one section, one sample (shared by the cascade, the bank and the tests)
+static inline PLL_HOT_TEXT int32_t pll_bq_section(const pll_bq_coef_t *c, int64_t *s1, int64_t *s2, int32_t x)
+{
+    uint64_t acc = (uint64_t)((int64_t)c->b0 * x) + (uint64_t)*s1;
+    int32_t  y = pll_sat32((int64_t)acc >> 30);
+    *s1 = (int64_t)((uint64_t)((int64_t)c->b1 * x) - (uint64_t)((int64_t)c->a1 * y) + (uint64_t)*s2);
+    *s2 = (int64_t)((uint64_t)((int64_t)c->b2 * x) - (uint64_t)((int64_t)c->a2 * y));
+    return c->shift ? pll_sat32((int64_t)y * ((int64_t)1 << c->shift)) : y;
+}
+
+static inline PLL_HOT_TEXT int32_t pll_bq_run(pll_bq_cascade_t *f, int32_t x)
+{
+    for (uint32_t k = 0; k < f->n; k++) x = pll_bq_section(&f->c[k], &f->s1[k], &f->s2[k], x);
+    return x;
+}
+
+// One sample per channel: y[ch] = cascade(x[ch]); x and y may alias.
+void pll_bq_bank_run(pll_bq_bank_t *b, const int32_t x[PLL_BQ_CH], int32_t y[PLL_BQ_CH]);
+
+#ifdef __cplusplus
+}
+#endif
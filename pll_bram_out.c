@@ -0,0 +1,112 @@
+#include "pll_bram_out.h"
+
+#define REC_W  3u   // words per record
+
+_Static_assert(sizeof(pll_bram_rec_t) == 4u * REC_W, "pll_bram_rec_t must be packed words");
+
+static inline uint32_t *buf_ptr(uint32_t *region, uint32_t b)
+{
+    return region + PLL_BRAM_OUT_HDR_W + b * (REC_W * PLL_BRAM_OUT_BLOCK_N);
+}
+
+static inline uint32_t lock_status(const pll_q30_state_t *st, uint32_t cnt)
+{
+    // from out_f, not delta_f_q25: that one stays 0 with PLL_OUT_DELTA=0 and
+    // would flag lock during pull-in (mod 2^32, so a wrapped out_f is exact)
+    int32_t df = (int32_t)((uint32_t)st->out_f_q25 - (50u << 25));
+    uint32_t lock = (df > -PLL_BRAM_LOCK_DF_Q25 && df < PLL_BRAM_LOCK_DF_Q25) ? PLL_BRAM_ST_LOCK : 0u;
+    return (cnt << 8) | lock;
+}
+
+void pll_bram_out_init(pll_bram_out_t *o, uintptr_t base_addr)
+{
+    if (!o) return;
+    o->region     = (uint32_t*)base_addr;
+    o->fill       = 0;
+    o->prod_idx   = 0;
+    o->sample_cnt = 0;
+    o->overruns   = 0;
+
+    volatile uint32_t *r = o->region;
+    r[0] = 0;
+    r[1] = PLL_BRAM_OUT_BLOCK_N;
+    r[2] = 0;
+    r[3] = 0;
+    r[4] = 0;
+    r[5] = 0;
+    r[6] = 0;
+    r[7] = 0;
+    __sync_synchronize();
+    r[0] = PLL_BRAM_OUT_MAGIC;
+    PLL_BRAM_OUT_WB(o->region, 4u * PLL_BRAM_OUT_HDR_W);
+}
+
+static int publish(pll_bram_out_t *o)
+{
+    volatile uint32_t *ctl = o->region;
+    uint32_t b = o->prod_idx & 1u;
+
+    o->fill = 0;
+    if (ctl[3 + b] != 0) {          // consumer still owns this buffer
+        o->overruns++;
+        ctl[5] = o->overruns;
+        return -1;
+    }
+
+    // Plain (non-volatile) word copy: the compiler may unroll/merge it and a
+    // cached mapping turns it into whole-line bursts on write-back.
+    uint32_t *dst = buf_ptr(o->region, b);
+    const uint32_t *src = (const uint32_t*)o->stage;
+    for (uint32_t i = 0; i < REC_W * PLL_BRAM_OUT_BLOCK_N; i++) dst[i] = src[i];
+    PLL_BRAM_OUT_WB(dst, 4u * REC_W * PLL_BRAM_OUT_BLOCK_N);
+
+    __sync_synchronize();           // data before handshake
+    o->prod_idx++;
+    ctl[3 + b] = o->prod_idx;       // block number + 1
+    ctl[2] = o->prod_idx;
+    PLL_BRAM_OUT_WB(o->region, 4u * PLL_BRAM_OUT_HDR_W);
+    return 1;
+}
+
+int pll_bram_out_put(pll_bram_out_t *o, const pll_q30_state_t *st)
+{
+    pll_bram_rec_t *r = &o->stage[o->fill];
+    r->out_f_q25 = st->out_f_q25;
+    r->theta_q30 = st->theta_q30;
+    r->status    = lock_status(st, o->sample_cnt++);
+
+    if (++o->fill < PLL_BRAM_OUT_BLOCK_N) return 0;
+    return publish(o);
+}
+
+void pll_bram_out_put_direct(uintptr_t base_addr, uint32_t idx, const pll_q30_state_t *st)
+{
+    volatile uint32_t *dst = (volatile uint32_t*)base_addr + PLL_BRAM_OUT_HDR_W
+                           + REC_W * (idx % (2u * PLL_BRAM_OUT_BLOCK_N));
+    dst[0] = (uint32_t)st->out_f_q25;
+    dst[1] = st->theta_q30;
+    dst[2] = lock_status(st, idx);
+}
+
+int32_t pll_bram_out_take(uint32_t *region, pll_bram_rec_t *out)
+{
+    volatile uint32_t *ctl = region;
+    uint32_t r0 = ctl[3], r1 = ctl[4];
+    uint32_t b;
+
+    if (r0 == 0 && r1 == 0) return -1;
+    if (r0 == 0)      b = 1;
+    else if (r1 == 0) b = 0;
+    else              b = ((int32_t)(r0 - r1) < 0) ? 0u : 1u;   // oldest first
+
+    uint32_t blk = b ? r1 : r0;
+    __sync_synchronize();
+
+    const uint32_t *src = buf_ptr(region, b);
+    uint32_t *dst = (uint32_t*)out;
+    for (uint32_t i = 0; i < REC_W * PLL_BRAM_OUT_BLOCK_N; i++) dst[i] = src[i];
+
+    __sync_synchronize();
+    ctl[3 + b] = 0;                 // release buffer to producer
+    return (int32_t)(blk - 1u);
+}
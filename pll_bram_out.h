@@ -0,0 +1,88 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+#include "pll_q30.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// BRAM output path: out_f / theta / lock status for HDL or other AXI masters.
+//
+// Samples are staged in local (cached) memory and copied to BRAM one block at
+// a time, so the AXI side sees back-to-back word writes (or a single cache
+// line flush burst) instead of one volatile store per field per sample.
+//
+// Region layout, 32-bit words from the region base:
+//   [0]  magic            PLL_BRAM_OUT_MAGIC
+//   [1]  block_n          records per block
+//   [2]  prod_idx         blocks published so far (free running)
+//   [3]  ready[0]         0 = free, else (block number + 1); consumer writes 0
+//   [4]  ready[1]
+//   [5]  overruns         blocks dropped because both buffers were busy
+//   [6..7] reserved
+//   [8 ...]               buffer 0: block_n records
+//   [8 + 3*block_n ...]   buffer 1: block_n records
+//
+// Handshake: producer fills buffer (prod_idx & 1) only if its ready word is 0,
+// then sets ready and bumps prod_idx. The consumer reads the buffer whose ready
+// word is non-zero and clears it when done.
+
+#define PLL_BRAM_OUT_MAGIC   0x4F4C4C50u   // "PLLO"
+#define PLL_BRAM_OUT_HDR_W   8u
+
+#ifndef PLL_BRAM_OUT_BLOCK_N
+#define PLL_BRAM_OUT_BLOCK_N 64u
+#endif
+
+// Lock flag threshold on |out_f - 50 Hz| (Hz in Q25). Default 0.5 Hz.
+#ifndef PLL_BRAM_LOCK_DF_Q25
+#define PLL_BRAM_LOCK_DF_Q25 (1 << 24)
+#endif
+
+// Status word: bit0 = lock, bits 31:8 = sample counter (low 24 bits)
+#define PLL_BRAM_ST_LOCK     0x1u
+
+// Write-back hook for a cached BRAM mapping, e.g.
+//   -DPLL_BRAM_OUT_WB(p,n)=Xil_DCacheFlushRange((UINTPTR)(p),(n))
+#ifndef PLL_BRAM_OUT_WB
+#define PLL_BRAM_OUT_WB(p, n) ((void)(p), (void)(n))
+#endif
+
+typedef struct {
+    int32_t  out_f_q25;
+    uint32_t theta_q30;
+    uint32_t status;
+} pll_bram_rec_t;
+
+typedef struct {
+    uint32_t *region;        // BRAM base for this path
+    uint32_t  fill;          // records staged
+    uint32_t  prod_idx;      // mirror of region[2]
+    uint32_t  sample_cnt;
+    uint32_t  overruns;
+    pll_bram_rec_t stage[PLL_BRAM_OUT_BLOCK_N];
+} pll_bram_out_t;
+
+// Region size in bytes for the compiled block size
+#define PLL_BRAM_OUT_BYTES \
+    (4u * (PLL_BRAM_OUT_HDR_W + 2u * 3u * PLL_BRAM_OUT_BLOCK_N))
+
+void pll_bram_out_init(pll_bram_out_t *o, uintptr_t base_addr);
+
+// Stage one sample; publishes a block every PLL_BRAM_OUT_BLOCK_N calls.
+// Returns 1 if a block was published, -1 if it was dropped (overrun), else 0.
+int  pll_bram_out_put(pll_bram_out_t *o, const pll_q30_state_t *st);
+
+// Baseline for comparison: one record straight to BRAM with volatile stores.
+void pll_bram_out_put_direct(uintptr_t base_addr, uint32_t idx, const pll_q30_state_t *st);
+
+// ---------- consumer side (host model / other masters) ----------
+// Copies the oldest ready block into out[] and releases it. Returns the block
+// number, or -1 if no block is ready.
+int32_t pll_bram_out_take(uint32_t *region, pll_bram_rec_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,124 @@
+#pragma once
+#include <stdint.h>
+
+// Build profiles and feature switches for the PLL library.
+//
+// Default (full): 1024-entry LUT NCO, every state output maintained.
+//
+// -DPLL_PROFILE_MINIMAL: for 16-32 KB instruction memories shared with other
+// control code. Single Q30 engine, quarter-wave NCO (257 words instead of
+// 1024), only the outputs the loop itself needs (sin, out_f, theta), only
+// the init/step entry points (no block, timestamp or snapshot API), no
+// 64-bit division and no printf anywhere in the library. Results are
+// bit-exact with the full build for out_f/theta/sin.
+//
+// Individual switches can still be overridden with -D.
+
+#if defined(PLL_PROFILE_MINIMAL)
+  #ifndef PLL_NCO_QUARTER
+    #define PLL_NCO_QUARTER 1
+  #endif
+  #ifndef PLL_OUT_COS
+    #define PLL_OUT_COS     0
+  #endif
+  #ifndef PLL_OUT_DELTA
+    #define PLL_OUT_DELTA   0
+  #endif
+  #ifndef PLL_FS_TRIM
+    #define PLL_FS_TRIM     0
+  #endif
+  #ifndef PLL_LOOP_FILTER
+    #define PLL_LOOP_FILTER 0
+  #endif
+  #ifndef PLL_API_BLOCK
+    #define PLL_API_BLOCK   0
+  #endif
+  #ifndef PLL_API_TS
+    #define PLL_API_TS      0
+  #endif
+  #ifndef PLL_API_SNAPSHOT
+    #define PLL_API_SNAPSHOT 0
+  #endif
+#endif
+
+// Engine used by pll_engine.h (compile-time choice)
+#define PLL_ENGINE_Q30      1     // pll_q30: reference, bit-exact with the HDL
+#define PLL_ENGINE_Q15      2     // pll_q15: 16-bit data path
+#define PLL_ENGINE_F32      3     // pll_f32: single-precision FPU
+#define PLL_ENGINE_Q30W     4     // pll_q30w: 64-bit PI, output clamp only (conditional integration)
+
+#ifndef PLL_ENGINE
+  #define PLL_ENGINE        PLL_ENGINE_Q30
+#endif
+#if defined(PLL_PROFILE_MINIMAL) && (PLL_ENGINE != PLL_ENGINE_Q30)
+  #error "PLL_PROFILE_MINIMAL builds the Q30 engine only"
+#endif
+
+#ifndef PLL_NCO_QUARTER
+  #define PLL_NCO_QUARTER   0     // 1: quarter-wave table + quadrant folding
+#endif
+#ifndef PLL_OUT_COS
+  #define PLL_OUT_COS       1     // 0: cos_q30 is not computed (stays 0)
+#endif
+#ifndef PLL_OUT_DELTA
+  #define PLL_OUT_DELTA     1     // 0: delta_f_q25 is not stored (stays 0)
+#endif
+#ifndef PLL_FS_TRIM
+  #define PLL_FS_TRIM       1     // 0: pll_q30_step ignores inv_fs_q40, uses the constant
+#endif
+#ifndef PLL_LOOP_FILTER
+  #define PLL_LOOP_FILTER   1     // 0: no pll_q30_step_lf (biquad cascade before the PI)
+#endif
+
+// Optional pll_q30 entry points; off in the minimal profile, where the loop
+// only needs pll_q30_init / pll_q30_step (about half of pll_q30.o .text)
+#ifndef PLL_API_BLOCK
+  #define PLL_API_BLOCK     1     // pll_q30_step_block
+#endif
+#ifndef PLL_API_TS
+  #define PLL_API_TS        1     // pll_q30_step_dt, pll_q30_step_block_ts (non-uniform sampling)
+#endif
+#ifndef PLL_API_SNAPSHOT
+  #define PLL_API_SNAPSHOT  1     // pll_q30_save, pll_q30_restore
+#endif
+
+// Fixed-point helper variants (pll_fixed.h), all bit-exact with the reference
+#ifndef PLL_FIXED_BRANCHLESS
+  #define PLL_FIXED_BRANCHLESS 0  // 1: sat32 as compare-and-select
+#endif
+#ifndef PLL_FIXED_MULH
+  #define PLL_FIXED_MULH    0     // 1: mul_q30 from mulh/mul halves (RV32)
+#endif
+
+// Sample rate (compile-time). The reciprocal is an integer constant
+// expression, folded by the compiler: no 64-bit division at run time.
+#ifndef PLL_FS_HZ
+  #define PLL_FS_HZ         40000
+#endif
+#define PLL_INV_FS_Q32 \
+    ((uint32_t)((((uint64_t)1u << 32) + (PLL_FS_HZ / 2)) / (uint64_t)PLL_FS_HZ))
+
+// Run-time copy in the pll_q30 state (inv_fs_q40), trimmed to the measured
+// rate by pll_pps.h: seconds in Q0.40, ~0.04 ppm per LSB at 40 kHz (Q32 would
+// be 9 ppm). The nominal value is PLL_INV_FS_Q32 << PLL_INV_FS_FRAC, so the
+// untrimmed phase increment is bit-exact with the HDL.
+#define PLL_INV_FS_FRAC     8
+#define PLL_INV_FS_Q40      ((uint32_t)PLL_INV_FS_Q32 << PLL_INV_FS_FRAC)
+#if PLL_FS_HZ <= 256
+  #error "PLL_INV_FS_Q40 needs PLL_FS_HZ > 256"
+#endif
+
+// Q-format shifts of the loop (HDL word lengths), used by the engines and by
+// the linear model in host/pll_q30_model.c:
+//   x_q30       = x_q22 << PLL_X_SHIFT
+//   delta_f_q25 = u_q30 >> PLL_DF_SHIFT                 (u = 1.0 -> 1 Hz)
+//   phase_inc   = (f_q25 * PLL_INV_FS_Q32) >> PLL_INC_SHIFT   (Q30 turns)
+#define PLL_X_SHIFT         8
+#define PLL_DF_SHIFT        5
+#define PLL_INC_SHIFT       27
+
+#if defined(PLL_PROFILE_MINIMAL)
+  #define PLL_PROFILE_NAME  "minimal"
+#else
+  #define PLL_PROFILE_NAME  "full"
+#endif
@@ -0,0 +1,103 @@
+#pragma once
+#include <stdint.h>
+
+#include "pll_config.h"
+#include "pll_q30.h"
+
+// Compile-time engine selection: -DPLL_ENGINE=PLL_ENGINE_{Q30,Q15,F32,Q30W}.
+//
+// Every engine takes Q22 input and reports out_f in Q25, so application code
+// (helloworld.c, host benchmarks) is written once against pll_engine_*.
+// pll_engine_view() returns the state in pll_q30_state_t form for consumers
+// such as pll_mailbox and pll_bram_out; for the Q30 engine it is the state
+// itself, for the others a converted copy in *scratch.
+
+#if PLL_ENGINE == PLL_ENGINE_Q30
+
+typedef pll_q30_state_t pll_engine_state_t;
+#define PLL_ENGINE_NAME "q30"
+#define PLL_ENGINE_STEP_FN pll_q30_step
+
+static inline void pll_engine_init(pll_engine_state_t *st, int32_t kp_q30, int32_t ki_q30) { pll_q30_init(st, kp_q30, ki_q30); }
+static inline void pll_engine_step(pll_engine_state_t *st, int32_t x_q22) { pll_q30_step(st, x_q22); }
+static inline int32_t pll_engine_out_f_q25(const pll_engine_state_t *st) { return st->out_f_q25; }
+
+static inline const pll_q30_state_t *pll_engine_view(const pll_engine_state_t *st, pll_q30_state_t *scratch)
+{
+    (void)scratch;
+    return st;
+}
+
+#elif PLL_ENGINE == PLL_ENGINE_Q15
+
+#include "pll_q15.h"
+typedef pll_q15_state_t pll_engine_state_t;
+#define PLL_ENGINE_NAME "q15"
+#define PLL_ENGINE_STEP_FN pll_q15_step
+
+static inline void pll_engine_init(pll_engine_state_t *st, int32_t kp_q30, int32_t ki_q30) { pll_q15_init(st, kp_q30, ki_q30); }
+static inline void pll_engine_step(pll_engine_state_t *st, int32_t x_q22) { pll_q15_step(st, pll_q15_from_q22(x_q22)); }
+static inline int32_t pll_engine_out_f_q25(const pll_engine_state_t *st) { return st->out_f_q25; }
+
+static inline const pll_q30_state_t *pll_engine_view(const pll_engine_state_t *st, pll_q30_state_t *scratch)
+{
+    scratch->theta_q30      = st->theta_q30;
+    scratch->integrator_q30 = st->integrator_q30;
+    scratch->sin_q30        = (int32_t)st->sin_q15 * 32768;
+    scratch->cos_q30        = (int32_t)st->cos_q15 * 32768;
+    scratch->out_f_q25      = st->out_f_q25;
+    scratch->delta_f_q25    = st->delta_f_q25;
+    scratch->inv_fs_q40     = PLL_INV_FS_Q40;     // fixed-rate engines
+    return scratch;
+}
+
+#elif PLL_ENGINE == PLL_ENGINE_F32
+
+#include "pll_f32.h"
+typedef pll_f32_state_t pll_engine_state_t;
+#define PLL_ENGINE_NAME "f32"
+#define PLL_ENGINE_STEP_FN pll_f32_step
+
+static inline void pll_engine_init(pll_engine_state_t *st, int32_t kp_q30, int32_t ki_q30) { pll_f32_init(st, kp_q30, ki_q30); }
+static inline void pll_engine_step(pll_engine_state_t *st, int32_t x_q22) { pll_f32_step(st, x_q22); }
+static inline int32_t pll_engine_out_f_q25(const pll_engine_state_t *st) { return pll_f32_out_f_q25(st); }
+
+static inline const pll_q30_state_t *pll_engine_view(const pll_engine_state_t *st, pll_q30_state_t *scratch)
+{
+    scratch->theta_q30      = pll_f32_theta_q30(st);
+    scratch->integrator_q30 = pll_f32_integrator_q30(st);
+    scratch->sin_q30        = pll_f32_sin_q30(st);
+    scratch->cos_q30        = pll_f32_cos_q30(st);
+    scratch->out_f_q25      = pll_f32_out_f_q25(st);
+    scratch->delta_f_q25    = pll_f32_delta_f_q25(st);
+    scratch->inv_fs_q40     = PLL_INV_FS_Q40;     // fixed-rate engines
+    return scratch;
+}
+
+#elif PLL_ENGINE == PLL_ENGINE_Q30W
+
+#include "pll_q30w.h"
+#include "pll_fixed.h"
+typedef pll_q30w_state_t pll_engine_state_t;
+#define PLL_ENGINE_NAME "q30w"
+#define PLL_ENGINE_STEP_FN pll_q30w_step
+
+static inline void pll_engine_init(pll_engine_state_t *st, int32_t kp_q30, int32_t ki_q30) { pll_q30w_init(st, kp_q30, ki_q30); }
+static inline void pll_engine_step(pll_engine_state_t *st, int32_t x_q22) { pll_q30w_step(st, x_q22); }
+static inline int32_t pll_engine_out_f_q25(const pll_engine_state_t *st) { return st->out_f_q25; }
+
+static inline const pll_q30_state_t *pll_engine_view(const pll_engine_state_t *st, pll_q30_state_t *scratch)
+{
+    scratch->theta_q30      = st->theta_q30;
+    scratch->integrator_q30 = pll_sat32_ref(st->integrator_q30);
+    scratch->sin_q30        = st->sin_q30;
+    scratch->cos_q30        = st->cos_q30;
+    scratch->out_f_q25      = st->out_f_q25;
+    scratch->delta_f_q25    = st->delta_f_q25;
+    scratch->inv_fs_q40     = PLL_INV_FS_Q40;     // fixed-rate engines
+    return scratch;
+}
+
+#else
+#error "Unknown PLL_ENGINE"
+#endif
@@ -0,0 +1,58 @@
+#include "pll_f32.h"
+#include "pll_config.h"
+#include "pll_sections.h"
+#include <stddef.h>
+
+#include "pll_nco.h"
+
+#define Q30_TO_F   (1.0f / 1073741824.0f)
+#define Q22_TO_F   (1.0f / 4194304.0f)
+
+// Q2.30 range, the float counterpart of sat32()
+static inline PLL_HOT_TEXT float sat_q2(float x)
+{
+    if (x >  2.0f) return  2.0f;
+    if (x < -2.0f) return -2.0f;
+    return x;
+}
+
+void pll_f32_init(pll_f32_state_t *st, int32_t kp_q30, int32_t ki_q30)
+{
+    if (!st) return;
+    *st = (pll_f32_state_t){0};
+    st->kp = (float)kp_q30 * Q30_TO_F;
+    st->ki = (float)ki_q30 * Q30_TO_F;
+    st->out_f = 50.0f;
+}
+
+PLL_HOT_TEXT void pll_f32_step(pll_f32_state_t *st, int32_t x_q22)
+{
+    // Hz -> Q30 turns per sample, same reciprocal as the Q30 engine (2^30/Fs)
+    const float HZ_TO_INC_Q30 = (float)PLL_INV_FS_Q32 * 0.25f;
+
+    // 1) NCO: same 1024-entry table and 10-bit index as the Q30 engine
+    uint32_t idx = (st->theta_q30 >> (30 - 10)) & (SINE_N - 1);
+    st->sin = (float)sine_q230[idx] * Q30_TO_F;
+#if PLL_OUT_COS
+    st->cos = (float)sine_q230[(idx + 256) & (SINE_N - 1)] * Q30_TO_F;
+#endif
+
+    // 2) x: Q22 -> float
+    float x = (float)x_q22 * Q22_TO_F;
+
+    // 3) Phase detector (placeholder, as in pll_q30_step)
+    float qerr = -x * st->sin;
+
+    // 4) PI
+    float p = st->kp * qerr;
+    st->integrator = sat_q2(st->integrator + st->ki * qerr);
+    float u = sat_q2(p + st->integrator);
+
+    // 5)-6) PI output is the frequency deviation in Hz (Q30 >> 5 -> Q25 keeps the value)
+    st->delta_f = u;
+    st->out_f = 50.0f + u;
+
+    // 7) theta update (truncating, like the Q30 >> 27)
+    int32_t phase_inc_q30 = (int32_t)(st->out_f * HZ_TO_INC_Q30);
+    st->theta_q30 = (st->theta_q30 + (uint32_t)phase_inc_q30) & 0x3FFFFFFF;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Single-precision float engine for cores with an FPU (newer soft cores,
+// Cortex-R). Same loop as pll_q30_step: same NCO table and 10-bit index,
+// same phase detector, PI ordering and out_f = 50 Hz + PI output, so results
+// track the Q30 engine to within float rounding. The phase accumulator is
+// kept as an integer turn count (exact wrap, no drift of the NCO index); the
+// float part is the signal path and the loop filter. The integrator and PI
+// sum are clamped to [-2, 2] like the sat32 calls of the Q30 engine, which
+// are reached during pull-in; the *_q30 accessors saturate +2.0 to INT32_MAX.
+//
+// I/O conventions are unchanged: input is Q22 (HDL Input_sine), gains are
+// Q2.30, and out_f/theta/sin/cos are available in the Q formats of
+// pll_q30_state_t through the *_q* accessors below.
+
+typedef struct {
+    float kp, ki;
+    uint32_t theta_q30;   // turns, Q30: the phase accumulator stays integer
+    float integrator;
+    float sin, cos;
+    float out_f;          // Hz
+    float delta_f;        // Hz
+} pll_f32_state_t;
+
+void pll_f32_init(pll_f32_state_t *st, int32_t kp_q30, int32_t ki_q30);
+void pll_f32_step(pll_f32_state_t *st, int32_t x_q22);
+
+static inline int32_t  pll_f32_out_f_q25(const pll_f32_state_t *st)   { return (int32_t)(st->out_f * 33554432.0f + 0.5f); }
+static inline int32_t  pll_f32_delta_f_q25(const pll_f32_state_t *st) { float v = st->delta_f * 33554432.0f; return (int32_t)(v < 0.0f ? v - 0.5f : v + 0.5f); }
+static inline uint32_t pll_f32_theta_q30(const pll_f32_state_t *st)   { return st->theta_q30; }
+
+// Q2.30, saturating: the integrator clamp reaches +2.0 exactly, one LSB past
+// INT32_MAX, where a plain (int32_t) cast is undefined (INT32_MIN on x86)
+static inline int32_t pll_f32_to_q30(float v)
+{
+    v *= 1073741824.0f;
+    if (v >=  2147483648.0f) return INT32_MAX;
+    if (v <= -2147483648.0f) return INT32_MIN;
+    return (int32_t)v;
+}
+static inline int32_t pll_f32_integrator_q30(const pll_f32_state_t *st) { return pll_f32_to_q30(st->integrator); }
+static inline int32_t pll_f32_sin_q30(const pll_f32_state_t *st)        { return pll_f32_to_q30(st->sin); }
+static inline int32_t pll_f32_cos_q30(const pll_f32_state_t *st)        { return pll_f32_to_q30(st->cos); }
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,112 @@
+#pragma once
+#include <stdint.h>
+
+#include "pll_config.h"
+#include "pll_sections.h"
+
+// Fixed-point helpers shared by the PLL engines.
+//
+// *_ref are the reference semantics (the original pll_q30.c helpers, i.e. the
+// HDL behaviour). Other variants are faster formulations that must stay
+// bit-exact with *_ref for every input; host/fixed_verify.c proves that
+// exhaustively on reduced domains and randomly on the full domain.
+// The unsuffixed names are what the engines call, selected by pll_config.h.
+
+// ---------- saturation ----------
+static inline PLL_HOT_TEXT int32_t pll_sat32_ref(int64_t x)
+{
+    if (x >  2147483647LL) return  2147483647;
+    if (x < -2147483648LL) return -2147483648;
+    return (int32_t)x;
+}
+
+// Compare-and-select: no data-dependent branch (cmov / czero on RISC-V Zicond)
+static inline PLL_HOT_TEXT int32_t pll_sat32_bl(int64_t x)
+{
+    int32_t lo  = (int32_t)x;
+    int32_t lim = (int32_t)((x >> 63) ^ 0x7FFFFFFF);   // INT32_MAX or INT32_MIN
+    return ((int64_t)lo == x) ? lo : lim;
+}
+
+static inline PLL_HOT_TEXT int16_t pll_sat16(int32_t x)
+{
+    if (x >  32767) return  32767;
+    if (x < -32768) return -32768;
+    return (int16_t)x;
+}
+
+static inline PLL_HOT_TEXT int32_t pll_add_sat32(int32_t a, int32_t b)
+{
+    int32_t r;
+    if (__builtin_add_overflow(a, b, &r)) return (a < 0) ? INT32_MIN : INT32_MAX;
+    return r;
+}
+
+// ---------- Q2.30 multiply ----------
+// Q2.30 * Q2.30 -> Q2.30
+static inline PLL_HOT_TEXT int32_t pll_mul_q30_ref(int32_t a, int32_t b)
+{
+    int64_t p = (int64_t)a * (int64_t)b; // Q4.60
+    p >>= 30;                            // -> Q2.30
+    return pll_sat32_ref(p);
+}
+
+// From the two 32-bit halves of the product (mulh + mul on RV32) without a
+// 64-bit shift. p >> 30 fits in 32 bits exactly when hi is in [-2^29, 2^29).
+static inline PLL_HOT_TEXT int32_t pll_mul_q30_mulh(int32_t a, int32_t b)
+{
+    int64_t  p  = (int64_t)a * (int64_t)b;
+    int32_t  hi = (int32_t)(p >> 32);
+    uint32_t lo = (uint32_t)p;
+    if (hi >=  (1 << 29)) return INT32_MAX;
+    if (hi <  -(1 << 29)) return INT32_MIN;
+    return (int32_t)(((uint32_t)hi << 2) | (lo >> 30));
+}
+
+// ---------- phase accumulator ----------
+// theta in [0, 1) turn as Q30; wraps modulo one turn for either sign of inc.
+static inline PLL_HOT_TEXT uint32_t pll_theta_add_q30(uint32_t theta_q30, int32_t inc_q30)
+{
+    return (theta_q30 + (uint32_t)inc_q30) & 0x3FFFFFFF;
+}
+
+// ---------- Q15 (lane semantics of the RISC-V P-extension ops) ----------
+// khm16: (a*b) >> 15, -1 * -1 saturates to 0x7FFF
+static inline PLL_HOT_TEXT int16_t pll_mul_q15(int16_t a, int16_t b)
+{
+    return pll_sat16(((int32_t)a * (int32_t)b) >> 15);
+}
+
+// ksub16(0, a)
+static inline PLL_HOT_TEXT int16_t pll_neg_q15(int16_t a)
+{
+    return pll_sat16(-(int32_t)a);
+}
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+// 8 lanes of pll_neg_q15(pll_mul_q15(x, s)) on host SSE2
+static inline __m128i pll_negmul_q15_x8(__m128i xv, __m128i sv)
+{
+    const __m128i min16 = _mm_set1_epi16(-32768);
+    // (x*s) >> 15 from the 32-bit product halves; only -1*-1 overflows
+    __m128i lo = _mm_mullo_epi16(xv, sv);
+    __m128i hi = _mm_mulhi_epi16(xv, sv);
+    __m128i q  = _mm_or_si128(_mm_slli_epi16(hi, 1), _mm_srli_epi16(lo, 15));
+    __m128i ovf = _mm_and_si128(_mm_cmpeq_epi16(xv, min16), _mm_cmpeq_epi16(sv, min16));
+    q = _mm_xor_si128(q, ovf);                          // 0x8000 -> 0x7FFF
+    return _mm_subs_epi16(_mm_setzero_si128(), q);      // saturating negate
+}
+#endif
+
+// ---------- selection ----------
+#if PLL_FIXED_BRANCHLESS
+  #define pll_sat32    pll_sat32_bl
+#else
+  #define pll_sat32    pll_sat32_ref
+#endif
+#if PLL_FIXED_MULH
+  #define pll_mul_q30  pll_mul_q30_mulh
+#else
+  #define pll_mul_q30  pll_mul_q30_ref
+#endif
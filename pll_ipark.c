@@ -0,0 +1,26 @@
+#include "pll_ipark.h"
+
+void pll_ipark_block(const int32_t *s_q30, const int32_t *c_q30, const int32_t *id_q30, const int32_t *iq_q30,
+                     unsigned flags, int32_t *a_q30, int32_t *b_q30, int32_t *c_out_q30, size_t n)
+{
+    if (!s_q30 || !c_q30 || !id_q30 || !iq_q30 || !a_q30 || !b_q30 || !c_out_q30) return;
+    for (size_t i = 0; i < n; i++) {
+        int32_t abc[3];
+        pll_ipark_abc(s_q30[i], c_q30[i], id_q30[i], iq_q30[i], flags, abc);
+        a_q30[i]     = abc[0];
+        b_q30[i]     = abc[1];
+        c_out_q30[i] = abc[2];
+    }
+}
+
+#if PLL_OUT_COS
+void pll_ipark_step_block(pll_q30_state_t *st, const int32_t *x_q22, const int32_t *id_q30,
+                          const int32_t *iq_q30, unsigned flags, int32_t *abc_q30, size_t n)
+{
+    if (!st || !x_q22 || !id_q30 || !iq_q30 || !abc_q30) return;
+    for (size_t i = 0; i < n; i++) {
+        pll_q30_step(st, x_q22[i]);
+        pll_ipark_step(st, id_q30[i], iq_q30[i], flags, &abc_q30[3 * i]);
+    }
+}
+#endif
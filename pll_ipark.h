@@ -0,0 +1,81 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+#include "pll_config.h"
+#include "pll_sections.h"
+#include "pll_fixed.h"
+#include "pll_q30.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// id/iq references -> three-phase references for the modulator, fused:
+// inverse Park on the loop's own sin/cos, inverse Clarke (amplitude
+// invariant), optional min-max zero-sequence injection, all Q2.30.
+//   alpha = id cos - iq sin          beta = id sin + iq cos
+//   a = alpha                        b, c = -alpha / 2 +- sqrt(3)/2 beta
+//   min-max: v0 = -(max(a,b,c) + min(a,b,c)) / 2 added to each phase,
+//   which stretches the linear range by 2/sqrt(3) for the same peak.
+// Intermediates stay 64-bit (|alpha| reaches 2 sqrt(2) for full-scale
+// id/iq); only the three outputs are saturated to Q2.30. No table access:
+// sin_q30/cos_q30 of the state are what pll_q30_step just evaluated (phase of
+// the sample it processed), so this runs straight after the step. For a
+// delay-compensated angle take sin/cos from pll_ref_eval() instead.
+//
+// pll_ipark_step() needs cos_q30 in the state, i.e. PLL_OUT_COS=1 (not in
+// PLL_PROFILE_MINIMAL).
+
+#define PLL_IPARK_ZSI        1u                      // flags: min-max injection
+#define PLL_SQRT3_2_Q30      929887697               // sqrt(3)/2, Q2.30
+
+static inline PLL_HOT_TEXT void pll_ipark_abc(int32_t s_q30, int32_t c_q30, int32_t id_q30, int32_t iq_q30,
+                                              unsigned flags, int32_t abc_q30[3])
+{
+    int64_t al = ((int64_t)id_q30 * c_q30 - (int64_t)iq_q30 * s_q30) >> 30;
+    // the sum reaches 2^63 when all four inputs are INT32_MIN: halve it first,
+    // exactly (floor), then >> 29
+    int64_t ps = (int64_t)id_q30 * s_q30, pc = (int64_t)iq_q30 * c_q30;
+    int64_t be = ((ps >> 1) + (pc >> 1) + (ps & pc & 1)) >> 29;
+    int64_t h  = -(al >> 1);
+    int64_t k  = (be * PLL_SQRT3_2_Q30) >> 30;
+    int64_t a = al, b = h + k, c = h - k;
+    if (flags & PLL_IPARK_ZSI) {
+        int64_t mx = a > b ? a : b, mn = a < b ? a : b;
+        mx = mx > c ? mx : c;
+        mn = mn < c ? mn : c;
+        int64_t v0 = -((mx + mn) >> 1);
+        a += v0;
+        b += v0;
+        c += v0;
+    }
+    abc_q30[0] = pll_sat32(a);
+    abc_q30[1] = pll_sat32(b);
+    abc_q30[2] = pll_sat32(c);
+}
+
+#if PLL_OUT_COS
+static inline PLL_HOT_TEXT void pll_ipark_step(const pll_q30_state_t *st, int32_t id_q30, int32_t iq_q30,
+                                               unsigned flags, int32_t abc_q30[3])
+{
+    pll_ipark_abc(st->sin_q30, st->cos_q30, id_q30, iq_q30, flags, abc_q30);
+}
+#endif
+
+// Block API (SoA): n samples of sin/cos and id/iq in, three phase arrays
+// out. Same result as n calls of pll_ipark_abc.
+void pll_ipark_block(const int32_t *s_q30, const int32_t *c_q30, const int32_t *id_q30, const int32_t *iq_q30,
+                     unsigned flags, int32_t *a_q30, int32_t *b_q30, int32_t *c_out_q30, size_t n);
+
+#if PLL_OUT_COS
+// Loop and modulator references together: steps st once per input sample
+// and writes the references for the angle of that sample to abc_q30, 3 * n
+// words interleaved a, b, c (modulator order).
+void pll_ipark_step_block(pll_q30_state_t *st, const int32_t *x_q22, const int32_t *id_q30,
+                          const int32_t *iq_q30, unsigned flags, int32_t *abc_q30, size_t n);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,178 @@
+#include "pll_mailbox.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Layout must not depend on the compiler/ABI: both sides map the same bytes.
+_Static_assert(sizeof(pll_mbox_rec_t) == 16, "pll_mbox_rec_t layout");
+_Static_assert(offsetof(pll_mbox_t, st_seq)  == 1 * PLL_MBOX_CACHELINE, "status line");
+_Static_assert(offsetof(pll_mbox_t, head)    == 2 * PLL_MBOX_CACHELINE, "producer line");
+_Static_assert(offsetof(pll_mbox_t, tail)    == 3 * PLL_MBOX_CACHELINE, "consumer line");
+_Static_assert(offsetof(pll_mbox_t, ring)    == 4 * PLL_MBOX_CACHELINE, "ring start");
+_Static_assert((PLL_MBOX_RING_N & (PLL_MBOX_RING_N - 1u)) == 0, "PLL_MBOX_RING_N must be 2^k");
+
+// ---------- ordering helpers ----------
+// GCC __atomic builtins: on RV32 without the A extension these are plain
+// aligned lw/sw plus `fence`, which is all a 1P/1C protocol needs.
+static inline uint32_t ld_acq(const uint32_t *p)      { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+static inline uint32_t ld_rlx(const uint32_t *p)      { return __atomic_load_n(p, __ATOMIC_RELAXED); }
+static inline void     st_rel(uint32_t *p, uint32_t v) { __atomic_store_n(p, v, __ATOMIC_RELEASE); }
+static inline void     st_rlx(uint32_t *p, uint32_t v) { __atomic_store_n(p, v, __ATOMIC_RELAXED); }
+
+// ---------- producer ----------
+void pll_mbox_init(pll_mbox_t *mb)
+{
+    if (!mb) return;
+
+    st_rlx(&mb->magic, 0);   // invalidate while (re)initializing
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    mb->version  = PLL_MBOX_VERSION;
+    mb->ring_n   = PLL_MBOX_RING_N;
+    mb->rec_size = (uint32_t)sizeof(pll_mbox_rec_t);
+
+    mb->st_seq = 0;
+    mb->st_count_lo = mb->st_count_hi = 0;
+    mb->st_out_f_q25 = mb->st_delta_f_q25 = 0;
+    mb->st_theta_q30 = 0;
+    mb->st_sin_q30 = mb->st_cos_q30 = 0;
+
+    mb->head = mb->dropped = mb->rec_seq = 0;
+    mb->tail = 0;
+
+    st_rel(&mb->magic, PLL_MBOX_MAGIC);
+    PLL_MBOX_WB(mb, 4 * PLL_MBOX_CACHELINE);
+}
+
+int pll_mbox_push(pll_mbox_t *mb, uint32_t event, const pll_q30_state_t *st)
+{
+    uint32_t head = ld_rlx(&mb->head);
+    PLL_MBOX_INV(&mb->tail, 4);
+    uint32_t tail = ld_acq(&mb->tail);
+    uint32_t seq  = mb->rec_seq++;
+
+    if ((uint32_t)(head - tail) >= PLL_MBOX_RING_N) {
+        st_rlx(&mb->dropped, ld_rlx(&mb->dropped) + 1u);
+        PLL_MBOX_WB(&mb->head, 12);
+        return -1;
+    }
+
+    pll_mbox_rec_t *r = &mb->ring[head & (PLL_MBOX_RING_N - 1u)];
+    r->seq       = seq;
+    r->event     = event;
+    r->out_f_q25 = st->out_f_q25;
+    r->theta_q30 = st->theta_q30;
+    PLL_MBOX_WB(r, sizeof(*r));
+
+    st_rel(&mb->head, head + 1u);   // record visible before the index
+    PLL_MBOX_WB(&mb->head, 12);
+    return 0;
+}
+
+void pll_mbox_publish_status(pll_mbox_t *mb, const pll_q30_state_t *st, uint64_t sample_count)
+{
+    uint32_t s = ld_rlx(&mb->st_seq);
+
+    st_rlx(&mb->st_seq, s + 1u);                  // odd: write in progress
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    // relaxed atomic stores: the reader loads these concurrently (seqlock)
+    st_rlx(&mb->st_count_lo,                   (uint32_t)sample_count);
+    st_rlx(&mb->st_count_hi,                   (uint32_t)(sample_count >> 32));
+    st_rlx((uint32_t*)&mb->st_out_f_q25,       (uint32_t)st->out_f_q25);
+    st_rlx((uint32_t*)&mb->st_delta_f_q25,     (uint32_t)st->delta_f_q25);
+    st_rlx(&mb->st_theta_q30,                  st->theta_q30);
+    st_rlx((uint32_t*)&mb->st_sin_q30,         (uint32_t)st->sin_q30);
+    st_rlx((uint32_t*)&mb->st_cos_q30,         (uint32_t)st->cos_q30);
+
+    st_rel(&mb->st_seq, s + 2u);                  // even: stable
+    PLL_MBOX_WB(&mb->st_seq, 32);
+}
+
+// ---------- consumer ----------
+int pll_mbox_check(const pll_mbox_t *mb)
+{
+    if (!mb) return -1;
+    if (ld_acq(&mb->magic) != PLL_MBOX_MAGIC) return -1;
+    if (mb->version != PLL_MBOX_VERSION)      return -1;
+    if (mb->ring_n != PLL_MBOX_RING_N)        return -1;
+    if (mb->rec_size != sizeof(pll_mbox_rec_t)) return -1;
+    return 0;
+}
+
+size_t pll_mbox_pop(pll_mbox_t *mb, pll_mbox_rec_t *out, size_t max)
+{
+    uint32_t tail = ld_rlx(&mb->tail);
+    uint32_t head = ld_acq(&mb->head);
+    size_t n = 0;
+
+    while (tail != head && n < max) {
+        out[n++] = mb->ring[tail & (PLL_MBOX_RING_N - 1u)];
+        tail++;
+    }
+    st_rel(&mb->tail, tail);                      // slots free only after copy
+    return n;
+}
+
+int pll_mbox_read_status(const pll_mbox_t *mb, pll_mbox_status_t *out, int max_retry)
+{
+    for (int i = 0; i < max_retry; i++) {
+        uint32_t s0 = ld_acq(&mb->st_seq);
+        if (s0 & 1u) continue;
+
+        pll_mbox_status_t t;
+        t.sample_count = ((uint64_t)ld_rlx(&mb->st_count_hi) << 32) | ld_rlx(&mb->st_count_lo);
+        t.out_f_q25    = (int32_t)ld_rlx((const uint32_t*)&mb->st_out_f_q25);
+        t.delta_f_q25  = (int32_t)ld_rlx((const uint32_t*)&mb->st_delta_f_q25);
+        t.theta_q30    = ld_rlx(&mb->st_theta_q30);
+        t.sin_q30      = (int32_t)ld_rlx((const uint32_t*)&mb->st_sin_q30);
+        t.cos_q30      = (int32_t)ld_rlx((const uint32_t*)&mb->st_cos_q30);
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (ld_rlx(&mb->st_seq) == s0) {
+            *out = t;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+// ---------- Linux mapping ----------
+#if defined(__linux__)
+static pll_mbox_t *map_fd(int fd, off_t off)
+{
+    void *p = mmap(NULL, sizeof(pll_mbox_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, off);
+    close(fd);
+    return (p == MAP_FAILED) ? NULL : (pll_mbox_t*)p;
+}
+
+pll_mbox_t *pll_mbox_shm_open(const char *name, int create)
+{
+    int fd = shm_open(name, create ? (O_RDWR | O_CREAT) : O_RDWR, 0666);
+    if (fd < 0) return NULL;
+    if (create && ftruncate(fd, (off_t)sizeof(pll_mbox_t)) != 0) {
+        close(fd);
+        return NULL;
+    }
+    return map_fd(fd, 0);
+}
+
+pll_mbox_t *pll_mbox_devmem_open(uint64_t phys_addr)
+{
+    long pg = sysconf(_SC_PAGESIZE);
+    if (pg <= 0 || (phys_addr & (uint64_t)(pg - 1))) return NULL;   // must be page aligned
+
+    int fd = open("/dev/mem", O_RDWR | O_SYNC);
+    if (fd < 0) return NULL;
+    return map_fd(fd, (off_t)phys_addr);
+}
+
+void pll_mbox_unmap(pll_mbox_t *mb)
+{
+    if (mb) munmap(mb, sizeof(pll_mbox_t));
+}
+#endif
@@ -0,0 +1,127 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+#include "pll_q30.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Shared-memory mailbox between the bare-metal PLL core (producer) and a
+// Linux application core (consumer).
+//
+// Layout (all fields fixed-width, identical on RV32 bare-metal and 64-bit Linux):
+//   line 0 : header   (magic, version, ring size, record size)
+//   line 1 : status   (seqlock: latest out_f/theta/sin/cos + sample counter)
+//   line 2 : producer (head index, dropped count)   -- written only by PLL core
+//   line 3 : consumer (tail index)                  -- written only by Linux side
+//   line 4+: ring of pll_mbox_rec_t
+//
+// Each writer owns its own cache line, so the two sides never false-share.
+// The ring is single-producer / single-consumer and lock-free: the producer
+// never blocks, a full ring drops the record and bumps `dropped`.
+
+#define PLL_MBOX_MAGIC      0x424D4C50u   // "PLMB"
+#define PLL_MBOX_VERSION    1u
+#define PLL_MBOX_CACHELINE  64u
+
+#ifndef PLL_MBOX_RING_N
+#define PLL_MBOX_RING_N     256u          // must be a power of two
+#endif
+
+// Cache maintenance hook for non-coherent interconnects (e.g. soft core with a
+// data cache in front of OCM/DDR shared with the APU). Default: no-op.
+// On Xilinx bare-metal:  -DPLL_MBOX_WB(p,n)=Xil_DCacheFlushRange((UINTPTR)(p),(n))
+#ifndef PLL_MBOX_WB
+#define PLL_MBOX_WB(p, n)   ((void)(p), (void)(n))
+#endif
+#ifndef PLL_MBOX_INV
+#define PLL_MBOX_INV(p, n)  ((void)(p), (void)(n))
+#endif
+
+// Event codes carried in pll_mbox_rec_t.event
+enum {
+    PLL_MBOX_EV_SAMPLE = 1,   // periodic out_f/theta sample
+    PLL_MBOX_EV_RESET  = 2,   // PLL (re)initialized
+    PLL_MBOX_EV_LOCK   = 3,
+    PLL_MBOX_EV_UNLOCK = 4,
+    PLL_MBOX_EV_USER   = 0x100
+};
+
+typedef struct {
+    uint32_t seq;        // producer record counter (gaps => drops)
+    uint32_t event;      // PLL_MBOX_EV_*
+    int32_t  out_f_q25;  // Hz in Q25 (HDL Out_f)
+    uint32_t theta_q30;  // turns in Q30
+} pll_mbox_rec_t;
+
+// Consistent copy of the status block
+typedef struct {
+    uint64_t sample_count;
+    int32_t  out_f_q25;
+    int32_t  delta_f_q25;
+    uint32_t theta_q30;
+    int32_t  sin_q30;
+    int32_t  cos_q30;
+} pll_mbox_status_t;
+
+typedef struct {
+    // line 0: header (written once at init)
+    uint32_t magic;
+    uint32_t version;
+    uint32_t ring_n;
+    uint32_t rec_size;
+    uint8_t  _pad0[PLL_MBOX_CACHELINE - 16];
+
+    // line 1: status seqlock (odd seq = write in progress)
+    uint32_t st_seq;
+    uint32_t st_count_lo;
+    uint32_t st_count_hi;
+    int32_t  st_out_f_q25;
+    int32_t  st_delta_f_q25;
+    uint32_t st_theta_q30;
+    int32_t  st_sin_q30;
+    int32_t  st_cos_q30;
+    uint8_t  _pad1[PLL_MBOX_CACHELINE - 32];
+
+    // line 2: producer-owned
+    uint32_t head;       // next slot to write (free-running)
+    uint32_t dropped;    // records lost because the ring was full
+    uint32_t rec_seq;    // next record sequence number
+    uint8_t  _pad2[PLL_MBOX_CACHELINE - 12];
+
+    // line 3: consumer-owned
+    uint32_t tail;       // next slot to read (free-running)
+    uint8_t  _pad3[PLL_MBOX_CACHELINE - 4];
+
+    // line 4+: ring
+    pll_mbox_rec_t ring[PLL_MBOX_RING_N];
+} pll_mbox_t;
+
+// ---------- producer (PLL core) ----------
+void pll_mbox_init(pll_mbox_t *mb);
+// Returns 0 on success, -1 if the ring was full (record dropped).
+int  pll_mbox_push(pll_mbox_t *mb, uint32_t event, const pll_q30_state_t *st);
+void pll_mbox_publish_status(pll_mbox_t *mb, const pll_q30_state_t *st, uint64_t sample_count);
+
+// ---------- consumer (Linux / analytics core) ----------
+// Returns 0 if the block carries a compatible header, -1 otherwise.
+int    pll_mbox_check(const pll_mbox_t *mb);
+// Copies up to max records out of the ring, returns the number copied.
+size_t pll_mbox_pop(pll_mbox_t *mb, pll_mbox_rec_t *out, size_t max);
+// Seqlock read. Returns 0 on success, -1 if no stable snapshot after max_retry.
+int    pll_mbox_read_status(const pll_mbox_t *mb, pll_mbox_status_t *out, int max_retry);
+
+#if defined(__linux__)
+// Map the mailbox from POSIX shared memory (/dev/shm/<name>), e.g. for host
+// testing with two processes. create!=0 creates/sizes the object.
+pll_mbox_t *pll_mbox_shm_open(const char *name, int create);
+// Map the mailbox from a physical address through /dev/mem (real SoC).
+pll_mbox_t *pll_mbox_devmem_open(uint64_t phys_addr);
+void        pll_mbox_unmap(pll_mbox_t *mb);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,166 @@
+#pragma once
+#include <stdint.h>
+
+#include "pll_config.h"
+#include "pll_sections.h"
+
+// NCO backends: theta (turns, Q30) -> sin/cos (Q2.30).
+// The LUT and quarter-wave backends use the top 10 bits of theta, like the
+// HDL LUT (bit-exact). Interpolated, CORDIC and recurrence trade cycles for
+// spur level; host/nco_sfdr.c measures each of them.
+
+#ifndef SINE_Q230_ATTR
+#define SINE_Q230_ATTR PLL_HOT_RODATA
+#endif
+#ifndef SINE_QTR_ATTR
+#define SINE_QTR_ATTR  PLL_HOT_RODATA
+#endif
+#include "sine_q230_1024.h"
+#include "sine_q230_quarter.h"
+
+// ---------- full 1024-entry table ----------
+static inline PLL_HOT_TEXT int32_t pll_nco_lut_sin_q30(uint32_t theta_q30)
+{
+    return sine_q230[(theta_q30 >> (30 - 10)) & (SINE_N - 1)];
+}
+
+static inline PLL_HOT_TEXT void pll_nco_lut_q30(uint32_t theta_q30, int32_t *s_q30, int32_t *c_q30)
+{
+    uint32_t idx = (theta_q30 >> (30 - 10)) & (SINE_N - 1); // 10-bit index
+    *s_q30 = sine_q230[idx];
+    *c_q30 = sine_q230[(idx + 256) & (SINE_N - 1)];
+}
+
+// ---------- quarter-wave table ----------
+// idx 0..1023: quadrant = idx[9:8], mirror inside odd quadrants, negate in the
+// second half-turn. Bit-exact with the full table.
+static inline PLL_HOT_TEXT int32_t pll_nco_quarter_at(uint32_t idx)
+{
+    uint32_t i = idx & (SINE_QTR_N - 1);
+    int32_t v = sine_q230_quarter[(idx & SINE_QTR_N) ? (SINE_QTR_N - i) : i];
+    return (idx & (2u * SINE_QTR_N)) ? -v : v;
+}
+
+static inline PLL_HOT_TEXT int32_t pll_nco_quarter_sin_q30(uint32_t theta_q30)
+{
+    return pll_nco_quarter_at((theta_q30 >> (30 - 10)) & (SINE_N - 1));
+}
+
+static inline PLL_HOT_TEXT void pll_nco_quarter_q30(uint32_t theta_q30, int32_t *s_q30, int32_t *c_q30)
+{
+    uint32_t idx = (theta_q30 >> (30 - 10)) & (SINE_N - 1);
+    *s_q30 = pll_nco_quarter_at(idx);
+    *c_q30 = pll_nco_quarter_at((idx + 256) & (SINE_N - 1));
+}
+
+// ---------- linearly interpolated table ----------
+// Same 1024-entry table, the 20 fractional bits of theta interpolate between
+// neighbours: 30-bit phase resolution, spurs ~60 dB lower than the plain
+// LUT for one multiply per output. Not bit-exact with the HDL.
+static inline PLL_HOT_TEXT int32_t pll_nco_interp_at(uint32_t theta_q30)
+{
+    uint32_t idx  = (theta_q30 >> (30 - 10)) & (SINE_N - 1);
+    int32_t  frac = (int32_t)(theta_q30 & ((1u << 20) - 1));
+    int32_t  a = sine_q230[idx];
+    int32_t  b = sine_q230[(idx + 1) & (SINE_N - 1)];
+    return a + (int32_t)(((int64_t)(b - a) * frac) >> 20);
+}
+
+static inline PLL_HOT_TEXT int32_t pll_nco_interp_sin_q30(uint32_t theta_q30)
+{
+    return pll_nco_interp_at(theta_q30);
+}
+
+static inline PLL_HOT_TEXT void pll_nco_interp_q30(uint32_t theta_q30, int32_t *s_q30, int32_t *c_q30)
+{
+    *s_q30 = pll_nco_interp_at(theta_q30);
+    *c_q30 = pll_nco_interp_at((theta_q30 + (1u << 28)) & 0x3FFFFFFF);   // + quarter turn
+}
+
+// ---------- CORDIC (rotation mode) ----------
+// No table beyond PLL_NCO_CORDIC_ITERS arctangents, full 30-bit phase, about
+// one bit of accuracy per iteration; shifts and adds only. Not bit-exact with
+// the HDL.
+#ifndef PLL_NCO_CORDIC_ITERS
+#define PLL_NCO_CORDIC_ITERS 24      // 16..30
+#endif
+
+#define PLL_NCO_CORDIC_K_Q30 652032874   // prod 1/sqrt(1 + 2^-2i), Q2.30
+
+// atan(2^-i) in turns, Q32
+static const int32_t pll_nco_atan_q32[30] PLL_HOT_RODATA = {
+    0x20000000, 0x12E4051E, 0x09FB385B, 0x051111D4, 0x028B0D43, 0x0145D7E1,
+    0x00A2F61E, 0x00517C55, 0x0028BE53, 0x00145F2F, 0x000A2F98, 0x000517CC,
+    0x00028BE6, 0x000145F3, 0x0000A2FA, 0x0000517D, 0x000028BE, 0x0000145F,
+    0x00000A30, 0x00000518, 0x0000028C, 0x00000146, 0x000000A3, 0x00000051,
+    0x00000029, 0x00000014, 0x0000000A, 0x00000005, 0x00000003, 0x00000001,
+};
+
+static inline PLL_HOT_TEXT void pll_nco_cordic_q30(uint32_t theta_q30, int32_t *s_q30, int32_t *c_q30)
+{
+    // angle as signed Q32 turns in [-1/2, 1/2); fold to [-1/4, 1/4) by a half turn
+    int32_t z = (int32_t)(theta_q30 << 2);
+    int neg = (z >= (1 << 30)) || (z < -(1 << 30));
+    if (neg) z = (int32_t)((uint32_t)z + 0x80000000u);
+
+    int32_t x = PLL_NCO_CORDIC_K_Q30, y = 0;
+    for (int i = 0; i < PLL_NCO_CORDIC_ITERS; i++) {
+        // rotate towards z = 0 without a data-dependent branch: m = z < 0 ? -1 : 0
+        int32_t m  = z >> 31;
+        int32_t dx = ((y >> i) ^ m) - m, dy = ((x >> i) ^ m) - m;
+        x -= dx;
+        y += dy;
+        z -= (pll_nco_atan_q32[i] ^ m) - m;
+    }
+    *s_q30 = neg ? -y : y;
+    *c_q30 = neg ? -x : x;
+}
+
+static inline PLL_HOT_TEXT int32_t pll_nco_cordic_sin_q30(uint32_t theta_q30)
+{
+    int32_t s, c;
+    pll_nco_cordic_q30(theta_q30, &s, &c);
+    return s;
+}
+
+// ---------- recurrence (rotating phasor) ----------
+// Stateful: (s, c) is rotated by a fixed increment every sample, 4 multiplies
+// plus a first-order amplitude correction (2 more). Cheapest per sample when
+// the frequency changes rarely (coefficients come from the CORDIC, once per
+// pll_nco_rec_set_inc); phase error accumulates with the rounding of the
+// coefficients, so resynchronise from theta now and then (pll_nco_rec_init).
+typedef struct {
+    int32_t s_q30, c_q30;     // current output
+    int32_t ks_q30, kc_q30;   // sin/cos of the increment
+} pll_nco_rec_t;
+
+static inline int32_t pll_nco_rnd_q30(int64_t p)
+{
+    return (int32_t)((p + (1 << 29)) >> 30);
+}
+
+static inline void pll_nco_rec_set_inc(pll_nco_rec_t *r, int32_t inc_q30)
+{
+    pll_nco_cordic_q30((uint32_t)inc_q30 & 0x3FFFFFFF, &r->ks_q30, &r->kc_q30);
+}
+
+static inline void pll_nco_rec_init(pll_nco_rec_t *r, uint32_t theta_q30, int32_t inc_q30)
+{
+    pll_nco_cordic_q30(theta_q30, &r->s_q30, &r->c_q30);
+    pll_nco_rec_set_inc(r, inc_q30);
+}
+
+// outputs the current sin/cos, then advances by one increment
+static inline PLL_HOT_TEXT void pll_nco_rec_step(pll_nco_rec_t *r, int32_t *s_q30, int32_t *c_q30)
+{
+    int32_t s = r->s_q30, c = r->c_q30;
+    *s_q30 = s;
+    *c_q30 = c;
+    int32_t sn = pll_nco_rnd_q30((int64_t)s * r->kc_q30 + (int64_t)c * r->ks_q30);
+    int32_t cn = pll_nco_rnd_q30((int64_t)c * r->kc_q30 - (int64_t)s * r->ks_q30);
+    // g = (3 - |v|^2) / 2 ~ 1/|v| near |v| = 1
+    int64_t m2 = ((int64_t)sn * sn + (int64_t)cn * cn) >> 30;             // Q30
+    int32_t g  = (int32_t)(((3LL << 30) - m2) >> 1);
+    r->s_q30 = pll_nco_rnd_q30((int64_t)sn * g);
+    r->c_q30 = pll_nco_rnd_q30((int64_t)cn * g);
+}
@@ -0,0 +1,223 @@
+#pragma once
+#include <stdint.h>
+
+#include "pll_config.h"
+#include "pll_sections.h"
+#include "pll_q30.h"
+#include "pll_nco.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Grid phase between samples (PWM sync, point-on-wave switching).
+//
+// After the step of sample k, theta_q30 is the phase at sample k + 1 and the
+// loop advances it by
+//   inc = out_f * (1/Fs)        (Q30 turns per sample, as in pll_q30_step)
+// until its next update. The phase dt samples after that instant is
+//   theta(dt) = theta_q30 + inc * dt          (mod 1 turn)
+// with dt signed Q16 (+-32768 samples): one 32x32 multiply, no float, no
+// divide. dt = -1.0 gives back the phase of sample k exactly. A timer-based
+// caller converts its tick count once: dt_q16 = ticks * (2^16 / ticks per
+// sample), the factor being a constant.
+//
+// A snapshot holds theta, inc and the sample index they belong to, so the
+// queries need nothing else from the loop. pll_phase_publish() /
+// pll_phase_read() pass it to another context (PWM ISR, main loop, second
+// hart on coherent memory) through a seqlock: the writer bumps seq to odd,
+// stores, bumps it to even; the reader retries until it sees the same even
+// seq around its copy. For a non-coherent Linux side use the status block of
+// pll_mailbox.h (theta and out_f are there too).
+//
+// Engines other than pll_q30 go through pll_engine_view().
+
+typedef struct {
+    uint32_t theta_q30;     // phase at sample `sample`
+    int32_t  inc_q30;       // phase advance per sample
+    uint32_t sample;        // caller's sample counter (wraps)
+} pll_phase_snap_t;
+
+typedef struct {
+    uint32_t seq;           // odd while pll_phase_publish() is writing
+    pll_phase_snap_t snap;
+} pll_phase_pub_t;
+
+// Phase increment of the last pll_q30_step (out_f times the reciprocal of
+// Fs): the loop's current rate estimate. After pll_q30_step_dt the step used
+// its own dt instead; this stays the per-sample rate.
+static inline PLL_HOT_TEXT int32_t pll_phase_inc_q30(const pll_q30_state_t *st)
+{
+#if PLL_FS_TRIM
+    int64_t prod = (int64_t)st->out_f_q25 * (int64_t)st->inv_fs_q40;
+    return (int32_t)(prod >> (PLL_INC_SHIFT + PLL_INV_FS_FRAC));
+#else
+    int64_t prod = (int64_t)st->out_f_q25 * (int64_t)PLL_INV_FS_Q32;
+    return (int32_t)(prod >> PLL_INC_SHIFT);
+#endif
+}
+
+// sample: index of the next sample, i.e. samples stepped so far
+static inline PLL_HOT_TEXT void pll_phase_take(pll_phase_snap_t *ps, const pll_q30_state_t *st, uint32_t sample)
+{
+    ps->theta_q30 = st->theta_q30;
+    ps->inc_q30   = pll_phase_inc_q30(st);
+    ps->sample    = sample;
+}
+
+// Phase dt_q16 samples after the snapshot instant (Q16, signed), Q30 turns
+static inline PLL_HOT_TEXT uint32_t pll_phase_at_q30(const pll_phase_snap_t *ps, int32_t dt_q16)
+{
+    int64_t d = ((int64_t)ps->inc_q30 * (int64_t)dt_q16) >> 16;
+    return (ps->theta_q30 + (uint32_t)d) & 0x3FFFFFFFu;
+}
+
+// Same instant given as a sample index plus a Q16 fraction of a sample
+static inline PLL_HOT_TEXT uint32_t pll_phase_at_sample_q30(const pll_phase_snap_t *ps, uint32_t n, uint32_t frac_q16)
+{
+    int32_t dt_q16 = (int32_t)(((n - ps->sample) << 16) + (frac_q16 & 0xFFFFu));
+    return pll_phase_at_q30(ps, dt_q16);
+}
+
+// sin/cos (Q2.30) at dt_q16. The interpolated table keeps the 30-bit phase:
+// the 10-bit LUT of the loop steps every 1/1024 turn (~20 us at 50 Hz, close
+// to a whole sample at 40 kHz), which would throw the sub-sample part away.
+static inline PLL_HOT_TEXT void pll_phase_sincos_at(const pll_phase_snap_t *ps, int32_t dt_q16,
+                                                    int32_t *s_q30, int32_t *c_q30)
+{
+    pll_nco_interp_q30(pll_phase_at_q30(ps, dt_q16), s_q30, c_q30);
+}
+
+// ---------- cross-context snapshot ----------
+// One writer (the context that steps the loop), any number of readers.
+static inline void pll_phase_pub_init(pll_phase_pub_t *pub)
+{
+    pub->snap.theta_q30 = 0;
+    pub->snap.inc_q30   = 0;
+    pub->snap.sample    = 0;
+    __atomic_store_n(&pub->seq, 0u, __ATOMIC_RELEASE);
+}
+
+// Call after pll_q30_step; `sample` as for pll_phase_take
+static inline PLL_HOT_TEXT void pll_phase_publish(pll_phase_pub_t *pub, const pll_q30_state_t *st, uint32_t sample)
+{
+    pll_phase_snap_t t;
+    pll_phase_take(&t, st, sample);
+
+    uint32_t s = __atomic_load_n(&pub->seq, __ATOMIC_RELAXED);
+    __atomic_store_n(&pub->seq, s + 1u, __ATOMIC_RELAXED);     // odd: write in progress
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&pub->snap.theta_q30, t.theta_q30, __ATOMIC_RELAXED);
+    __atomic_store_n(&pub->snap.inc_q30,   t.inc_q30,   __ATOMIC_RELAXED);
+    __atomic_store_n(&pub->snap.sample,    t.sample,    __ATOMIC_RELAXED);
+    __atomic_store_n(&pub->seq, s + 2u, __ATOMIC_RELEASE);     // even: stable
+}
+
+// Returns 0 with a consistent copy in *ps, -1 if every try overlapped a
+// write. A reader that can preempt the writer (higher-priority ISR) never
+// sees the write finish while it spins: keep the previous snapshot on -1,
+// it is one loop update older but extrapolates the same way.
+static inline int pll_phase_read(const pll_phase_pub_t *pub, pll_phase_snap_t *ps, int max_retry)
+{
+    for (int i = 0; i < max_retry; i++) {
+        uint32_t s0 = __atomic_load_n(&pub->seq, __ATOMIC_ACQUIRE);
+        if (s0 & 1u) continue;
+
+        pll_phase_snap_t t;
+        t.theta_q30 = __atomic_load_n(&pub->snap.theta_q30, __ATOMIC_RELAXED);
+        t.inc_q30   = __atomic_load_n(&pub->snap.inc_q30,   __ATOMIC_RELAXED);
+        t.sample    = __atomic_load_n(&pub->snap.sample,    __ATOMIC_RELAXED);
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&pub->seq, __ATOMIC_RELAXED) == s0) {
+            *ps = t;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+// ---------- crossing-time predictor ----------
+// Time from the snapshot instant until theta reaches a target phase, at the
+// current rate:
+//   t = ((target - theta) mod 1 turn) / inc            (samples, Q16 out)
+// The divide is a multiply by r = 2^50 / inc (Q50, fits 32 bits for
+// inc > 2^18, i.e. out_f >~ 9.8 Hz at 40 kHz). r is tracked with one Newton
+// step per update,
+//   r' = r * (2 - inc * r / 2^50)
+// which squares the relative error: the rate moves by a few ppm per sample
+// in lock, so r stays at full precision for two multiplies. A rate change
+// of more than 25% (pull-in, reset) reseeds from the leading-zero count of
+// inc and converges in ~5 updates (pll_zc_init runs them at once).
+// Targets are values of theta. The multiplier detector (qerr = -x sin theta)
+// locks theta a quarter turn behind the input, PLL_THETA_LAG_Q30; the input
+// crossings are the NCO's shifted back by that, 3/4 turn positive-going and
+// 1/4 turn negative-going.
+#define PLL_ZC_INC_MIN     (1 << 18)
+#define PLL_THETA_LAG_Q30  (1u << 28)      // input phase - theta, in lock
+#define PLL_ZC_NCO_POS_Q30 0u              // sin theta, positive-going
+#define PLL_ZC_NCO_NEG_Q30 (1u << 29)      // sin theta, negative-going
+#define PLL_ZC_POS_Q30     ((PLL_ZC_NCO_POS_Q30 - PLL_THETA_LAG_Q30) & 0x3FFFFFFFu)   // input, positive-going
+#define PLL_ZC_NEG_Q30     ((PLL_ZC_NCO_NEG_Q30 - PLL_THETA_LAG_Q30) & 0x3FFFFFFFu)   // input, negative-going
+
+typedef struct {
+    int32_t  inc_q30;       // rate the reciprocal belongs to
+    uint32_t recip_q50;     // 2^50 / inc_q30, 0 while inc <= PLL_ZC_INC_MIN
+} pll_zc_t;
+
+// inc = d 2^(m+1), d in [1/2, 1): 2^(49-m) (3 - 2d) is the chord of 1/d,
+// 0 to +12.5% above 2^50 / inc, so Newton never reaches the reseed threshold
+// from a seed. Written as 2^(49-m) + (2^(m+1) - inc) 2^(49-2m): 32-bit, and
+// below 2^32 for inc > 2^18.
+static inline uint32_t pll_zc_seed(uint32_t inc)
+{
+    int m = 31 - __builtin_clz(inc), sh = 49 - 2 * m;
+    uint32_t rest = (2u << m) - inc;
+    return (1u << (49 - m)) + (sh >= 0 ? rest << sh : rest >> -sh);
+}
+
+// Returns 0, or -1 (and no valid prediction) for inc <= PLL_ZC_INC_MIN
+static inline PLL_HOT_TEXT int pll_zc_set_inc(pll_zc_t *z, int32_t inc_q30)
+{
+    z->inc_q30 = inc_q30;
+    if (inc_q30 <= PLL_ZC_INC_MIN) { z->recip_q50 = 0; return -1; }
+
+    uint32_t r = z->recip_q50 ? z->recip_q50 : pll_zc_seed((uint32_t)inc_q30);
+    // 1 - inc * r, Q32; >= 25% off means the rate jumped: reseed
+    int64_t e = (int64_t)((1ull << 50) - (uint64_t)inc_q30 * r) >> 18;
+    if (e >= (1 << 30) || e <= -(1 << 30)) {
+        r = pll_zc_seed((uint32_t)inc_q30);
+        e = (int64_t)((1ull << 50) - (uint64_t)inc_q30 * r) >> 18;
+    }
+    z->recip_q50 = (uint32_t)((int64_t)r + (((int64_t)r * e) >> 32));
+    return 0;
+}
+
+// Once per sample, after pll_q30_step (or with a snapshot's inc_q30 through
+// pll_zc_set_inc in another context)
+static inline PLL_HOT_TEXT int pll_zc_update(pll_zc_t *z, const pll_q30_state_t *st)
+{
+    return pll_zc_set_inc(z, pll_phase_inc_q30(st));
+}
+
+static inline int pll_zc_init(pll_zc_t *z, const pll_q30_state_t *st)
+{
+    z->recip_q50 = 0;
+    int rc = 0;
+    for (int i = 0; i < 5; i++) rc = pll_zc_update(z, st);
+    return rc;
+}
+
+// Samples (Q16) from the instant of theta_q30 until the phase is target_q30;
+// 0 when it is there now, under one period otherwise. 0xFFFFFFFF without a
+// valid rate.
+static inline PLL_HOT_TEXT uint32_t pll_zc_time_q16(const pll_zc_t *z, uint32_t theta_q30, uint32_t target_q30)
+{
+    if (!z->recip_q50) return 0xFFFFFFFFu;
+    uint32_t dphi = (target_q30 - theta_q30) & 0x3FFFFFFFu;
+    return (uint32_t)(((uint64_t)dphi * z->recip_q50) >> 34);
+}
+
+#ifdef __cplusplus
+}
+#endif
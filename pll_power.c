@@ -0,0 +1,81 @@
+#include "pll_power.h"
+#include "pll_sections.h"
+#include "pll_fixed.h"
+
+#define INV3_Q30        357913941       // 1/3, Q2.30
+#define INV_SQRT3_Q30   619925131       // 1/sqrt(3), Q2.30
+
+void pll_pwr_init(pll_pwr_bank_t *b, unsigned flags)
+{
+    if (!b) return;
+    *b = (pll_pwr_bank_t){0};
+    b->flags = flags;
+}
+
+// alpha/beta of one three-phase quantity, Q22
+static inline void clarke(const int32_t x[3][PLL_PWR_N], int k, int32_t *al, int32_t *be)
+{
+    int64_t a = x[0][k], bb = x[1][k], c = x[2][k];
+    *al = pll_sat32(((2 * a - bb - c) * INV3_Q30) >> 30);
+    *be = pll_sat32(((bb - c) * INV_SQRT3_Q30) >> 30);
+}
+
+PLL_HOT_TEXT int pll_pwr_step(pll_pwr_bank_t *b, uint32_t theta_q30, int32_t s_q30, int32_t c_q30,
+                              const int32_t v_q22[3][PLL_PWR_N], const int32_t i_q22[3][PLL_PWR_N])
+{
+    if (!b || !v_q22 || !i_q22) return 0;
+    int32_t val[PLL_PWR_N], vbe[PLL_PWR_N], ial[PLL_PWR_N], ibe[PLL_PWR_N];
+
+    for (int k = 0; k < PLL_PWR_N; k++) {
+        clarke(v_q22, k, &val[k], &vbe[k]);
+        clarke(i_q22, k, &ial[k], &ibe[k]);
+    }
+
+    // Q22 * Q22 = Q44 -> Q30, times 3/2
+    for (int k = 0; k < PLL_PWR_N; k++) {
+        int64_t p = ((int64_t)val[k] * ial[k] + (int64_t)vbe[k] * ibe[k]) >> 14;
+        int64_t q = ((int64_t)vbe[k] * ial[k] - (int64_t)val[k] * ibe[k]) >> 14;
+        b->p_q30[k] = pll_sat32((3 * p) >> 1);
+        b->q_q30[k] = pll_sat32((3 * q) >> 1);
+    }
+
+    if (b->flags & PLL_PWR_DQ)
+        for (int k = 0; k < PLL_PWR_N; k++) {
+            b->vd_q22[k] = pll_sat32(((int64_t)val[k] * c_q30 + (int64_t)vbe[k] * s_q30) >> 30);
+            b->vq_q22[k] = pll_sat32(((int64_t)vbe[k] * c_q30 - (int64_t)val[k] * s_q30) >> 30);
+            b->id_q22[k] = pll_sat32(((int64_t)ial[k] * c_q30 + (int64_t)ibe[k] * s_q30) >> 30);
+            b->iq_q22[k] = pll_sat32(((int64_t)ibe[k] * c_q30 - (int64_t)ial[k] * s_q30) >> 30);
+        }
+
+    if (!(b->flags & PLL_PWR_AVG)) return 0;
+
+    // cycle boundary: theta wrapped past 0 since the last sample
+    int wrap = theta_q30 < b->theta_prev;
+    int done = 0;
+    b->theta_prev = theta_q30;
+    if (wrap) {
+        if (b->started && b->count) {
+            uint32_t recip_q32 = 0xFFFFFFFFu / b->count;       // 2^32 / count, 32-bit divide
+            for (int k = 0; k < PLL_PWR_N; k++) {
+                b->p_avg_q30[k] = pll_sat32(((b->p_sum[k] >> 16) * (int64_t)recip_q32) >> 16);
+                b->q_avg_q30[k] = pll_sat32(((b->q_sum[k] >> 16) * (int64_t)recip_q32) >> 16);
+            }
+            b->cycles++;
+            done = 1;
+        }
+        b->started = 1;
+        b->count = 0;
+        for (int k = 0; k < PLL_PWR_N; k++) b->p_sum[k] = b->q_sum[k] = 0;
+    }
+    if (b->count >= PLL_PWR_MAX_CYCLE) {       // no wrap (not locked): start over
+        b->started = 0;
+        b->count = 0;
+        for (int k = 0; k < PLL_PWR_N; k++) b->p_sum[k] = b->q_sum[k] = 0;
+    }
+    for (int k = 0; k < PLL_PWR_N; k++) {
+        b->p_sum[k] += b->p_q30[k];
+        b->q_sum[k] += b->q_q30[k];
+    }
+    b->count++;
+    return done;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <stdint.h>
+
+#include "pll_config.h"
+#include "pll_q30.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Instantaneous active/reactive power for a bank of three-phase feeders, on
+// the loop's reference frame.
+//
+// Per sample and feeder (voltages and currents Q22 like the loop input,
+// 1.0 = 2^22 = 1 pu):
+//   Clarke (amplitude invariant)  x_al = (2 xa - xb - xc) / 3, x_be = (xb - xc) / sqrt(3)
+//   Park on the loop's sin/cos    x_d = x_al cos + x_be sin, x_q = x_be cos - x_al sin
+//   p = 3/2 (v_d i_d + v_q i_q),  q = 3/2 (v_q i_d - v_d i_q)          (Q30 pu)
+// A rotation leaves p and q unchanged, so they are evaluated on alpha/beta
+// (4 products instead of 12); the dq components are only formed when asked
+// for (PLL_PWR_DQ), with the sin/cos the loop already has, so there is no
+// trigonometry of its own either way.
+//
+// PLL_PWR_AVG: p and q are also summed over each loop cycle, from one wrap
+// of theta to the next, and averaged at the wrap (mean = sum * 2^32/count,
+// one 32-bit divide per cycle for the whole bank, no 64-bit division). The
+// window is a whole number of samples, so the 2f ripple of unbalanced loads
+// leaks through at up to about 1/count of its amplitude.
+//
+// SoA: every array is indexed by feeder, so each stage is one loop over
+// PLL_PWR_N lanes that the compiler vectorizes on host (-O3, 32x32->64
+// multiplies: AVX2 vpmuldq).
+
+#ifndef PLL_PWR_N
+#define PLL_PWR_N 8
+#endif
+
+#define PLL_PWR_AVG          1u      // cycle averages in p_avg/q_avg
+#define PLL_PWR_DQ           2u      // v_d/v_q/i_d/i_q per sample
+
+#define PLL_PWR_MAX_CYCLE    65535u  // samples without a wrap: averaging restarts
+
+typedef struct {
+    unsigned flags;
+    // per sample
+    int32_t  p_q30[PLL_PWR_N], q_q30[PLL_PWR_N];
+    int32_t  vd_q22[PLL_PWR_N], vq_q22[PLL_PWR_N], id_q22[PLL_PWR_N], iq_q22[PLL_PWR_N];
+    // last complete cycle (valid once cycles > 0)
+    int32_t  p_avg_q30[PLL_PWR_N], q_avg_q30[PLL_PWR_N];
+    uint32_t cycles;
+    // running cycle
+    int64_t  p_sum[PLL_PWR_N], q_sum[PLL_PWR_N];
+    uint32_t count;
+    uint32_t theta_prev;
+    int      started;                // first wrap seen
+} pll_pwr_bank_t;
+
+void pll_pwr_init(pll_pwr_bank_t *b, unsigned flags);
+
+// v_q22[ph][k], i_q22[ph][k]: phase ph (a, b, c) of feeder k. s/c: sin/cos
+// of theta (Q2.30), theta: the loop phase for the cycle boundary. Returns 1
+// when a new cycle average was stored, else 0.
+int  pll_pwr_step(pll_pwr_bank_t *b, uint32_t theta_q30, int32_t s_q30, int32_t c_q30,
+                  const int32_t v_q22[3][PLL_PWR_N], const int32_t i_q22[3][PLL_PWR_N]);
+
+#if PLL_OUT_COS
+// After pll_q30_step: sin_q30/cos_q30 of the state and its theta
+static inline int pll_pwr_step_st(pll_pwr_bank_t *b, const pll_q30_state_t *st,
+                                  const int32_t v_q22[3][PLL_PWR_N], const int32_t i_q22[3][PLL_PWR_N])
+{
+    return pll_pwr_step(b, st->theta_q30, st->sin_q30, st->cos_q30, v_q22, i_q22);
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
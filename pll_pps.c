@@ -0,0 +1,70 @@
+#include "pll_pps.h"
+
+#if defined(PLL_PROFILE_MINIMAL)
+#error "pll_pps needs a 64-bit division and PLL_FS_TRIM; not part of PLL_PROFILE_MINIMAL"
+#endif
+
+void pll_pps_init(pll_pps_t *p, uint32_t fs_nom_hz)
+{
+    if (!p) return;
+    *p = (pll_pps_t){0};
+    p->fs_nom_hz = fs_nom_hz ? fs_nom_hz : PLL_FS_HZ;
+    // the HDL-rounded constant at the compile-time rate, else round(2^40 / fs)
+    p->inv_fs_q40 = (p->fs_nom_hz == PLL_FS_HZ) ? PLL_INV_FS_Q40
+                  : (uint32_t)((((uint64_t)1u << 40) + p->fs_nom_hz / 2) / p->fs_nom_hz);
+}
+
+// (n * 2^32 - t * fs_nom) / (t * fs_nom), in 1e-6 * `scale`; t < 2^40
+static int64_t rel_err(uint64_t dn, uint64_t dt_q32, uint32_t fs_nom, int64_t scale)
+{
+    int64_t expect = (int64_t)(dt_q32 * fs_nom);               // samples, Q32
+    int64_t diff   = (int64_t)(dn << 32) - expect;
+    return diff * scale / (expect / 1000000 ? expect / 1000000 : 1);
+}
+
+int pll_pps_edge(pll_pps_t *p, uint64_t sample_n, uint64_t t_q32)
+{
+    if (!p) return -1;
+    const uint32_t H = PLL_PPS_HIST;
+    const uint64_t T_MAX = (uint64_t)1u << 40;                  // 256 s, keeps Q32 * fs in range
+    int rejected = 0;
+
+    if (p->count) {
+        uint32_t prev = (p->head + H - 1u) & (H - 1u);
+        uint64_t dn = sample_n - p->n[prev], dt = t_q32 - p->t_q32[prev];
+        if (sample_n <= p->n[prev] || t_q32 <= p->t_q32[prev] || dt >= T_MAX) {
+            rejected = 1;
+        } else {
+            int64_t e = rel_err(dn, dt, p->fs_nom_hz, 1);
+            rejected = e > (int64_t)PLL_PPS_TOL_PPM || e < -(int64_t)PLL_PPS_TOL_PPM;
+        }
+        if (rejected) {
+            p->rejected++;
+            p->count = 0;
+        }
+    }
+
+    p->n[p->head] = sample_n;
+    p->t_q32[p->head] = t_q32;
+    p->head = (p->head + 1u) & (H - 1u);
+    if (p->count < H) p->count++;
+
+    // window: newest edge back to the oldest one that keeps the span < T_MAX
+    uint32_t last = (p->head + H - 1u) & (H - 1u), old = (p->head + H - p->count) & (H - 1u);
+    while (p->count > 1u && p->t_q32[last] - p->t_q32[old] >= T_MAX) {
+        p->count--;
+        old = (old + 1u) & (H - 1u);
+    }
+    if (p->count < 2u) return rejected ? -1 : 1;
+
+    uint64_t dn = p->n[last] - p->n[old], dt = p->t_q32[last] - p->t_q32[old];
+    uint32_t est = (uint32_t)(((dt << PLL_INV_FS_FRAC) + dn / 2) / dn);
+    p->ppb = (int32_t)rel_err(dn, dt, p->fs_nom_hz, 1000);
+
+    // smooth: inv += (est - inv) / 2^k, at least one LSB towards est
+    int64_t d = (int64_t)est - (int64_t)p->inv_fs_q40;
+    int64_t step = d / (1 << PLL_PPS_SMOOTH_SHIFT);
+    if (step == 0 && d != 0) step = d > 0 ? 1 : -1;
+    p->inv_fs_q40 = (uint32_t)((int64_t)p->inv_fs_q40 + step);
+    return rejected ? -1 : 0;
+}
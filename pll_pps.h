@@ -0,0 +1,62 @@
+#pragma once
+#include <stdint.h>
+
+#include "pll_config.h"
+#include "pll_q30.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Sample-rate estimation against a reference clock (PPS, or any edge with a
+// trusted timestamp).
+//
+// At each reference edge the caller passes the ADC sample counter and the
+// reference time of the edge. Over a window of the last PLL_PPS_HIST edges
+//   inv_fs = (t_newest - t_oldest) / (n_newest - n_oldest)      [s, Q0.40]
+// which averages the +-1 sample quantization of the counter over the whole
+// window (25 ppm per 1 s edge at 40 kHz -> ~1.7 ppm over 15 s), and the
+// applied value moves towards it by 1/2^PLL_PPS_SMOOTH_SHIFT per edge so the
+// loop sees no frequency step. An edge whose interval disagrees with the
+// nominal rate by more than PLL_PPS_TOL_PPM (missed or spurious pulse) restarts
+// the window.
+//
+// Cost: one 64-bit division per edge, nothing per sample. pll_pps_apply()
+// stores the result in the pll_q30 state (build with PLL_FS_TRIM=1, the
+// default; not part of PLL_PROFILE_MINIMAL).
+
+#ifndef PLL_PPS_HIST
+#define PLL_PPS_HIST          16u      // edges in the window, power of two
+#endif
+#ifndef PLL_PPS_TOL_PPM
+#define PLL_PPS_TOL_PPM       1000u    // per-edge interval check against nominal
+#endif
+#ifndef PLL_PPS_SMOOTH_SHIFT
+#define PLL_PPS_SMOOTH_SHIFT  2        // applied value: 1/4 of the way per edge
+#endif
+
+typedef struct {
+    uint64_t n[PLL_PPS_HIST];          // sample counter at each edge
+    uint64_t t_q32[PLL_PPS_HIST];      // reference time of each edge, s Q32.32
+    uint32_t head;                     // next slot
+    uint32_t count;                    // edges in the window
+    uint32_t fs_nom_hz;
+    uint32_t inv_fs_q40;               // smoothed, what pll_pps_apply() stores
+    int32_t  ppb;                      // window estimate of Fs vs nominal, 1e-9
+    uint32_t rejected;                 // edges that restarted the window
+} pll_pps_t;
+
+void pll_pps_init(pll_pps_t *p, uint32_t fs_nom_hz);
+
+// Returns 0 when the estimate was updated, 1 while the window has fewer than
+// two edges, -1 if the edge was rejected (the window restarts from it).
+int  pll_pps_edge(pll_pps_t *p, uint64_t sample_n, uint64_t t_q32);
+
+static inline void pll_pps_apply(const pll_pps_t *p, pll_q30_state_t *st)
+{
+    st->inv_fs_q40 = p->inv_fs_q40;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,164 @@
+#include "pll_q15.h"
+#include "pll_config.h"
+#include "pll_sections.h"
+#include "pll_fixed.h"
+#include <stddef.h>
+
+#define SINE_Q15_ATTR PLL_HOT_RODATA
+#include "sine_q15_1024.h"
+
+// Gains >= 1.0 would need a left shift; the kernels only shift right
+static inline int gain_ok(int32_t k_q30) { return k_q30 >= -(1 << 30) && k_q30 < (1 << 30); }
+
+// Q2.30 gain in [-1, 1) -> Q15 mantissa + shift (largest shift that still fits int16)
+static void split_gain(int32_t k_q30, int16_t *m, uint8_t *sh)
+{
+    int s = 15;
+    while (s > 0) {
+        int32_t v = k_q30 >> (15 - s);
+        if (v >= -32768 && v <= 32767) break;
+        s--;
+    }
+    *m  = (int16_t)(k_q30 >> (15 - s));
+    *sh = (uint8_t)s;
+}
+
+// Loop tail shared by the scalar and bank kernels: PI sum -> out_f -> theta.
+static inline PLL_HOT_TEXT int32_t freq_and_theta(int32_t u_q30, uint32_t *theta_q30, int32_t *delta_f_q25)
+{
+    int32_t delta = u_q30 >> PLL_DF_SHIFT;             // Q30 -> Q25, cannot overflow
+    int32_t f_q25 = (int32_t)(50 << 25) + delta;
+    int32_t phase_inc_q30 = (int32_t)(((int64_t)f_q25 * (int64_t)PLL_INV_FS_Q32) >> PLL_INC_SHIFT);
+    *theta_q30 = (*theta_q30 + (uint32_t)phase_inc_q30) & 0x3FFFFFFF;
+    *delta_f_q25 = delta;
+    return f_q25;
+}
+
+// ---------- single channel ----------
+int16_t pll_q15_from_q22(int32_t x_q22)
+{
+    return pll_sat16(x_q22 >> 7);
+}
+
+int pll_q15_init(pll_q15_state_t *st, int32_t kp_q30, int32_t ki_q30)
+{
+    if (!st || !gain_ok(kp_q30) || !gain_ok(ki_q30)) return -1;
+    *st = (pll_q15_state_t){0};
+    split_gain(kp_q30, &st->kp_m, &st->kp_sh);
+    split_gain(ki_q30, &st->ki_m, &st->ki_sh);
+    st->out_f_q25 = (int32_t)(50 << 25);
+    return 0;
+}
+
+PLL_HOT_TEXT void pll_q15_step(pll_q15_state_t *st, int16_t x_q15)
+{
+    // 1) NCO (Q15 table, same 10-bit index as the Q30 path)
+    uint32_t idx = (st->theta_q30 >> (30 - 10)) & (SINE_Q15_N - 1);
+    st->sin_q15 = sine_q15[idx];
+#if PLL_OUT_COS
+    st->cos_q15 = sine_q15[(idx + 256) & (SINE_Q15_N - 1)];
+#endif
+
+    // 2) Phase detector: 16x16 -> Q15
+    int16_t qerr_q15 = pll_neg_q15(pll_mul_q15(x_q15, st->sin_q15));
+
+    // 3) PI: 16x16 -> 32 products, 32-bit accumulators (Q30)
+    int32_t p_q30 = ((int32_t)st->kp_m * qerr_q15) >> st->kp_sh;
+    int32_t i_q30 = ((int32_t)st->ki_m * qerr_q15) >> st->ki_sh;
+    st->integrator_q30 = pll_add_sat32(st->integrator_q30, i_q30);
+    int32_t u_q30 = pll_add_sat32(p_q30, st->integrator_q30);
+
+    // 4) out_f and theta (32-bit, identical to pll_q30_step)
+    int32_t delta_f_q25;
+    st->out_f_q25 = freq_and_theta(u_q30, &st->theta_q30, &delta_f_q25);
+#if PLL_OUT_DELTA
+    st->delta_f_q25 = delta_f_q25;
+#endif
+}
+
+// ---------- bank ----------
+int pll_q15_bank_init(pll_q15_bank_t *b, int32_t kp_q30, int32_t ki_q30)
+{
+    if (!b || !gain_ok(kp_q30) || !gain_ok(ki_q30)) return -1;
+    *b = (pll_q15_bank_t){0};
+    split_gain(kp_q30, &b->kp_m, &b->kp_sh);
+    split_gain(ki_q30, &b->ki_m, &b->ki_sh);
+    for (int i = 0; i < PLL_Q15_BANK_N; i++) b->out_f_q25[i] = (int32_t)(50 << 25);
+    return 0;
+}
+
+// 16-bit part of the loop: qerr and the two PI products for every channel.
+#if defined(PLL_Q15_RVP) && defined(__riscv) && (__riscv_xlen == 32)
+// 2 lanes per 32-bit register (RV32 P extension)
+static inline uint32_t rvp_khm16(uint32_t a, uint32_t b)  { uint32_t r; __asm__("khm16 %0, %1, %2"  : "=r"(r) : "r"(a), "r"(b)); return r; }
+static inline uint32_t rvp_ksub16(uint32_t a, uint32_t b) { uint32_t r; __asm__("ksub16 %0, %1, %2" : "=r"(r) : "r"(a), "r"(b)); return r; }
+static inline int32_t  rvp_smbb16(uint32_t a, uint32_t b) { int32_t r;  __asm__("smbb16 %0, %1, %2" : "=r"(r) : "r"(a), "r"(b)); return r; }
+static inline int32_t  rvp_smtt16(uint32_t a, uint32_t b) { int32_t r;  __asm__("smtt16 %0, %1, %2" : "=r"(r) : "r"(a), "r"(b)); return r; }
+
+static PLL_HOT_TEXT void bank_products(const pll_q15_bank_t *b, const int16_t *x,
+                                       int32_t *p_q30, int32_t *i_q30)
+{
+    const uint32_t kp2 = (uint16_t)b->kp_m * 0x00010001u;
+    const uint32_t ki2 = (uint16_t)b->ki_m * 0x00010001u;
+    for (int i = 0; i < PLL_Q15_BANK_N; i += 2) {
+        uint32_t x2 = (uint16_t)x[i] | ((uint32_t)(uint16_t)x[i + 1] << 16);
+        uint32_t s2 = (uint16_t)b->sin_q15[i] | ((uint32_t)(uint16_t)b->sin_q15[i + 1] << 16);
+        uint32_t q2 = rvp_ksub16(0, rvp_khm16(x2, s2));
+        p_q30[i]     = rvp_smbb16(kp2, q2) >> b->kp_sh;
+        p_q30[i + 1] = rvp_smtt16(kp2, q2) >> b->kp_sh;
+        i_q30[i]     = rvp_smbb16(ki2, q2) >> b->ki_sh;
+        i_q30[i + 1] = rvp_smtt16(ki2, q2) >> b->ki_sh;
+    }
+}
+#elif defined(__SSE2__) && (PLL_Q15_BANK_N % 8) == 0
+// 8 lanes per register
+static void bank_products(const pll_q15_bank_t *b, const int16_t *x,
+                          int32_t *p_q30, int32_t *i_q30)
+{
+    const __m128i kp = _mm_set1_epi16(b->kp_m);
+    const __m128i ki = _mm_set1_epi16(b->ki_m);
+    const __m128i kp_sh = _mm_cvtsi32_si128(b->kp_sh);
+    const __m128i ki_sh = _mm_cvtsi32_si128(b->ki_sh);
+
+    for (int i = 0; i < PLL_Q15_BANK_N; i += 8) {
+        __m128i xv = _mm_loadu_si128((const __m128i*)&x[i]);
+        __m128i sv = _mm_loadu_si128((const __m128i*)&b->sin_q15[i]);
+        __m128i q  = pll_negmul_q15_x8(xv, sv);
+
+        // 16x16 -> 32
+        __m128i plo = _mm_mullo_epi16(kp, q), phi = _mm_mulhi_epi16(kp, q);
+        __m128i ilo = _mm_mullo_epi16(ki, q), ihi = _mm_mulhi_epi16(ki, q);
+        _mm_storeu_si128((__m128i*)&p_q30[i],     _mm_sra_epi32(_mm_unpacklo_epi16(plo, phi), kp_sh));
+        _mm_storeu_si128((__m128i*)&p_q30[i + 4], _mm_sra_epi32(_mm_unpackhi_epi16(plo, phi), kp_sh));
+        _mm_storeu_si128((__m128i*)&i_q30[i],     _mm_sra_epi32(_mm_unpacklo_epi16(ilo, ihi), ki_sh));
+        _mm_storeu_si128((__m128i*)&i_q30[i + 4], _mm_sra_epi32(_mm_unpackhi_epi16(ilo, ihi), ki_sh));
+    }
+}
+#else
+static PLL_HOT_TEXT void bank_products(const pll_q15_bank_t *b, const int16_t *x,
+                                       int32_t *p_q30, int32_t *i_q30)
+{
+    for (int i = 0; i < PLL_Q15_BANK_N; i++) {
+        int16_t q = pll_neg_q15(pll_mul_q15(x[i], b->sin_q15[i]));
+        p_q30[i] = ((int32_t)b->kp_m * q) >> b->kp_sh;
+        i_q30[i] = ((int32_t)b->ki_m * q) >> b->ki_sh;
+    }
+}
+#endif
+
+PLL_HOT_TEXT void pll_q15_bank_step(pll_q15_bank_t *b, const int16_t *x_q15)
+{
+    int32_t p_q30[PLL_Q15_BANK_N], i_q30[PLL_Q15_BANK_N];
+
+    for (int i = 0; i < PLL_Q15_BANK_N; i++)
+        b->sin_q15[i] = sine_q15[(b->theta_q30[i] >> (30 - 10)) & (SINE_Q15_N - 1)];
+
+    bank_products(b, x_q15, p_q30, i_q30);
+
+    for (int i = 0; i < PLL_Q15_BANK_N; i++) {
+        int32_t delta_f_q25;
+        b->integrator_q30[i] = pll_add_sat32(b->integrator_q30[i], i_q30[i]);
+        int32_t u_q30 = pll_add_sat32(p_q30[i], b->integrator_q30[i]);
+        b->out_f_q25[i] = freq_and_theta(u_q30, &b->theta_q30[i], &delta_f_q25);
+    }
+}
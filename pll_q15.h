@@ -0,0 +1,63 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Q15 data-path variant of pll_q30 for 12-16 bit ADCs.
+//
+// Same loop as pll_q30_step, but the signal path (input, NCO, phase detector,
+// PI products) is 16x16->32 with 32-bit accumulators. The frequency/phase
+// path (out_f_q25, theta_q30) stays 32-bit: a 16-bit phase accumulator would
+// only resolve Fs/2^16 = 0.6 Hz.
+//
+// PI gains are given in Q2.30 like pll_q30_init and stored as a 16-bit
+// mantissa plus a right shift (gain = m * 2^-(15+sh)), so small ki keeps its
+// precision without widening the multiplier. That covers gains in [-1, 1)
+// (kp_q30, ki_q30 in [-2^30, 2^30)); the init functions return -1 and leave
+// the state untouched for anything larger, which pll_q30 would accept.
+//
+// Packed SIMD: the bank kernel runs 2 lanes per register with the RISC-V P
+// extension (-DPLL_Q15_RVP, toolchain must accept khm16/ksub16/smbb16/smtt16)
+// and 8 lanes per register with SSE2 on host. All kernels are bit-exact with
+// pll_q15_step.
+
+typedef struct {
+    int16_t  kp_m, ki_m;      // gain mantissas (Q15)
+    uint8_t  kp_sh, ki_sh;    // extra right shifts
+    uint32_t theta_q30;       // turns, Q30
+    int32_t  integrator_q30;
+    int16_t  sin_q15;
+    int16_t  cos_q15;
+    int32_t  out_f_q25;       // Hz, Q25 (HDL Out_f)
+    int32_t  delta_f_q25;
+} pll_q15_state_t;
+
+// 0 on success, -1 if a gain is outside [-1, 1).
+int  pll_q15_init(pll_q15_state_t *st, int32_t kp_q30, int32_t ki_q30);
+void pll_q15_step(pll_q15_state_t *st, int16_t x_q15);
+
+// Q22 (HDL Input_sine) -> Q15 with saturation, for sharing stimulus with pll_q30
+int16_t pll_q15_from_q22(int32_t x_q22);
+
+// ---------- multi-channel bank (SoA) ----------
+#ifndef PLL_Q15_BANK_N
+#define PLL_Q15_BANK_N 8          // multiple of 8 for the SSE2 kernel
+#endif
+
+typedef struct {
+    int16_t  kp_m, ki_m;
+    uint8_t  kp_sh, ki_sh;
+    uint32_t theta_q30[PLL_Q15_BANK_N];
+    int32_t  integrator_q30[PLL_Q15_BANK_N];
+    int16_t  sin_q15[PLL_Q15_BANK_N];
+    int32_t  out_f_q25[PLL_Q15_BANK_N];
+} pll_q15_bank_t;
+
+int  pll_q15_bank_init(pll_q15_bank_t *b, int32_t kp_q30, int32_t ki_q30);
+void pll_q15_bank_step(pll_q15_bank_t *b, const int16_t *x_q15);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,36 +1,52 @@
 #include "pll_q30.h"
+#include "pll_config.h"
+#include "pll_sections.h"
+#include "pll_fixed.h"
+#include "pll_range.h"
 #include <stddef.h>
+#if PLL_LOOP_FILTER
+#include "pll_biquad.h"
+#endif
 
 // We will reuse your existing Q2.30 sine table (1024 samples) to generate sin/cos from theta.
 // You already have: sine_q230[SINE_N] in sine_q230_1024.h
-#include "sine_q230_1024.h"
+// pll_nco.h includes it (and the quarter-wave table) with the hot-path placement.
+#include "pll_nco.h"
 
 #ifndef SINE_N
 #define SINE_N 1024
 #endif
 
 // ---------- fixed-point helpers ----------
-static inline int32_t sat32(int64_t x)
+// Reference semantics and the optimized variants are in pll_fixed.h.
+static inline PLL_HOT_TEXT int32_t sat32(int64_t x)
 {
-    if (x >  2147483647LL) return  2147483647;
-    if (x < -2147483648LL) return -2147483648;
-    return (int32_t)x;
+    return pll_sat32(x);
 }
 
 // Q2.30 * Q2.30 -> Q2.30
-static inline int32_t mul_q30(int32_t a, int32_t b)
+static inline PLL_HOT_TEXT int32_t mul_q30(int32_t a, int32_t b)
 {
-    int64_t p = (int64_t)a * (int64_t)b; // Q4.60
-    p >>= 30;                            // -> Q2.30
-    return sat32(p);
+    return pll_mul_q30(a, b);
 }
 
 // theta_q30 in [0,1) turn (Q30). Use top 10 bits for 1024-LUT.
-static inline void sincos_from_theta_turn_q30(uint32_t theta_q30, int32_t* s_q30, int32_t* c_q30)
+static inline PLL_HOT_TEXT void sincos_from_theta_turn_q30(uint32_t theta_q30, int32_t* s_q30, int32_t* c_q30)
 {
-    uint32_t idx = (theta_q30 >> (30 - 10)) & (SINE_N - 1); // 10-bit index
-    *s_q30 = sine_q230[idx];
-    *c_q30 = sine_q230[(idx + 256) & (SINE_N - 1)];
+#if PLL_NCO_QUARTER
+    pll_nco_quarter_q30(theta_q30, s_q30, c_q30);
+#else
+    pll_nco_lut_q30(theta_q30, s_q30, c_q30);
+#endif
+}
+
+static inline PLL_HOT_TEXT int32_t sin_from_theta_turn_q30(uint32_t theta_q30)
+{
+#if PLL_NCO_QUARTER
+    return pll_nco_quarter_sin_q30(theta_q30);
+#else
+    return pll_nco_lut_sin_q30(theta_q30);
+#endif
 }
 
 void pll_q30_init(pll_q30_state_t *st, int32_t kp_q30, int32_t ki_q30)
@@ -46,6 +62,8 @@ void pll_q30_init(pll_q30_state_t *st, int32_t kp_q30, int32_t ki_q30)
     // Start at nominal 50 Hz exactly like HDL Constant_out1
     st->out_f_q25 = (int32_t)(50 << 25);   // 0x64000000
     st->delta_f_q25 = 0;
+
+    st->inv_fs_q40 = PLL_INV_FS_Q40;
 }
 
 // Core step:
@@ -55,47 +73,187 @@ void pll_q30_init(pll_q30_state_t *st, int32_t kp_q30, int32_t ki_q30)
 // NOTE: This is still a simplified phase detector (not full SOGI-Park-Norm).
 // The critical part for "HDL-compatible comparison" at this stage is:
 //   (a) same I/O scaling, (b) out_f meaning is "Hz estimate", (c) theta update from out_f/Fs.
-void pll_q30_step(pll_q30_state_t *st, int32_t x_q22)
+//
+// dt: time to the next sample in seconds, Q(dt_frac): the reciprocal of Fs
+// (INV_FS_Q32 = round(2^32 / FS), or the trimmed Q40 copy in the state) or a
+// measured interval, so the theta update needs no divide either way.
+static PLL_STEP_INLINE PLL_HOT_TEXT void step_q30(pll_q30_state_t *st, int32_t x_q22, uint32_t dt, int dt_frac,
+                                                   struct pll_bq_cascade *lf)
 {
-    // Fs sabit: 40 kHz
-    const int32_t FS_HZ = 40000;
-
-    // (2^32)/FS  ~ reciprocal for fast divide
-    // INV_FS_Q32 = round(2^32 / FS)
-    // Not: FS sabit olduğu için bunu const tutmak güvenli.
-    const uint32_t INV_FS_Q32 = (uint32_t)((((uint64_t)1u << 32) + (FS_HZ/2)) / (uint64_t)FS_HZ);
-
     // 1) NCO: sin/cos(theta) (theta: turns in Q30)
+#if PLL_OUT_COS
     sincos_from_theta_turn_q30(st->theta_q30, &st->sin_q30, &st->cos_q30);
+#else
+    st->sin_q30 = sin_from_theta_turn_q30(st->theta_q30);
+#endif
 
-    // 2) x: Q22 -> Q30
-    int32_t x_q30 = (int32_t)(x_q22 << 8);
+    // 2) x: Q22 -> Q30 (shift as unsigned: << of a negative value is UB in C;
+    //    the bits are the same, out-of-range inputs wrap like the HDL)
+    int32_t x_q30 = (int32_t)((uint32_t)x_q22 << PLL_X_SHIFT);
+    PLL_RANGE_REC(PLL_RANGE_X_Q30, (int64_t)x_q22 * (1 << PLL_X_SHIFT), x_q30);
 
     // 3) Phase detector (placeholder)
-    int32_t qerr_q30 = -mul_q30(x_q30, st->sin_q30);
+    //    mul_q30 can return INT32_MIN; negate with wrap instead of UB
+    int32_t qerr_q30 = (int32_t)(0u - (uint32_t)mul_q30(x_q30, st->sin_q30));
+    PLL_RANGE_REC(PLL_RANGE_QERR_Q30, -(((int64_t)x_q30 * st->sin_q30) >> 30), qerr_q30);
+
+    // 3b) Optional loop filter (pll_q30_step_lf); lf is a constant NULL in
+    //     the other entry points, so they compile without it
+#if PLL_LOOP_FILTER
+    if (lf) qerr_q30 = pll_bq_run(lf, qerr_q30);
+#else
+    (void)lf;
+#endif
 
     // 4) PI (Q30)
     int32_t p_q30 = mul_q30(st->kp_q30, qerr_q30);
-    st->integrator_q30 = sat32((int64_t)st->integrator_q30 + (int64_t)mul_q30(st->ki_q30, qerr_q30));
-    int32_t u_q30 = sat32((int64_t)p_q30 + (int64_t)st->integrator_q30);
+    PLL_RANGE_REC(PLL_RANGE_P_Q30, ((int64_t)st->kp_q30 * qerr_q30) >> 30, p_q30);
+    int64_t integ_sum = (int64_t)st->integrator_q30 + (int64_t)mul_q30(st->ki_q30, qerr_q30);
+    st->integrator_q30 = sat32(integ_sum);
+    PLL_RANGE_REC(PLL_RANGE_INTEG_Q30, integ_sum, st->integrator_q30);
+    int64_t u_sum = (int64_t)p_q30 + (int64_t)st->integrator_q30;
+    int32_t u_q30 = sat32(u_sum);
+    PLL_RANGE_REC(PLL_RANGE_U_Q30, u_sum, u_q30);
 
     // 5) PI output -> delta_f (Q25)
-    st->delta_f_q25 = sat32((int64_t)u_q30 >> 5);
+    int32_t delta_f_q25 = sat32((int64_t)u_q30 >> PLL_DF_SHIFT);
+    PLL_RANGE_REC(PLL_RANGE_DELTA_F_Q25, (int64_t)u_q30 >> PLL_DF_SHIFT, delta_f_q25);
+#if PLL_OUT_DELTA
+    st->delta_f_q25 = delta_f_q25;
+#endif
 
     // 6) out_f (Hz in Q25) = 50Hz + delta
-    int32_t f_q25 = (int32_t)(50 << 25) + st->delta_f_q25;
+    int32_t f_q25 = (int32_t)(50 << 25) + delta_f_q25;
     st->out_f_q25 = f_q25;
 
     // 7) theta update:
     // phase_inc_q30 = (f_q25 << 5) / FS
     // Fast form: ((f_q25 * INV_FS_Q32) >> 27)
     // Çünkü: (f_q25<<5)/FS ≈ (f_q25 * (2^32/FS)) >> (32-5) = >>27
-    int64_t prod = (int64_t)f_q25 * (int64_t)INV_FS_Q32;
-    int32_t phase_inc_q30 = (int32_t)(prod >> 27);
+    // With a measured dt the same form gives f * dt; an increment of a turn
+    // or more (dt >~ 20 ms) wraps modulo 2^32, which keeps theta mod 1 turn.
+    // A Q40 dt shifts 8 more: (f * (inv << 8)) >> 35 == (f * inv) >> 27.
+    int64_t prod = (int64_t)f_q25 * (int64_t)dt;
+    int32_t phase_inc_q30 = (int32_t)(prod >> (PLL_INC_SHIFT + dt_frac - 32));
+    PLL_RANGE_REC(PLL_RANGE_PHASE_INC_Q30, prod >> (PLL_INC_SHIFT + dt_frac - 32), phase_inc_q30);
+
+    st->theta_q30 = pll_theta_add_q30(st->theta_q30, phase_inc_q30);
+}
+
+PLL_HOT_TEXT void pll_q30_step(pll_q30_state_t *st, int32_t x_q22)
+{
+    // Fs sabit: 40 kHz (PLL_FS_HZ)
+
+    // (2^32)/FS  ~ reciprocal for fast divide
+    // INV_FS_Q32 = round(2^32 / FS)
+    // Not: FS sabit olduğu için bunu const tutmak güvenli (derleme zamanında katlanır).
+    // PLL_FS_TRIM: the state copy (Q40) instead, trimmed against a reference
+    // clock by pll_pps.h; one load per sample, the update costs nothing here.
+#if PLL_FS_TRIM
+    step_q30(st, x_q22, st->inv_fs_q40, 32 + PLL_INV_FS_FRAC, NULL);
+#else
+    const uint32_t INV_FS_Q32 = PLL_INV_FS_Q32;
+
+    step_q30(st, x_q22, INV_FS_Q32, 32, NULL);
+#endif
+}
 
-    st->theta_q30 = (st->theta_q30 + (uint32_t)phase_inc_q30) & 0x3FFFFFFF;
+#if PLL_API_TS
+PLL_HOT_TEXT void pll_q30_step_dt(pll_q30_state_t *st, int32_t x_q22, uint32_t dt_q32)
+{
+    step_q30(st, x_q22, dt_q32, 32, NULL);
+}
+#endif
+
+#if PLL_LOOP_FILTER
+PLL_HOT_TEXT void pll_q30_step_lf(pll_q30_state_t *st, struct pll_bq_cascade *lf, int32_t x_q22)
+{
+#if PLL_FS_TRIM
+    step_q30(st, x_q22, st->inv_fs_q40, 32 + PLL_INV_FS_FRAC, lf);
+#else
+    step_q30(st, x_q22, PLL_INV_FS_Q32, 32, lf);
+#endif
+}
+#endif
+
+
+#if PLL_API_BLOCK
+void pll_q30_step_block(pll_q30_state_t *st, const int32_t *x_q22, int32_t *out_f_q25, size_t n)
+{
+    if (!st || !x_q22) return;
+    for (size_t i = 0; i < n; i++) {
+        pll_q30_step(st, x_q22[i]);
+        if (out_f_q25) out_f_q25[i] = st->out_f_q25;
+    }
+}
+#endif
+
+#if PLL_API_TS
+void pll_q30_step_block_ts(pll_q30_state_t *st, const int32_t *x_q22, const uint64_t *t_q32,
+                           int32_t *out_f_q25, size_t n)
+{
+    if (!st || !x_q22 || !t_q32) return;
+    for (size_t i = 0; i < n; i++) {
+        // non-increasing timestamps hold theta; gaps clamp at ~1 s
+        uint64_t dt = (t_q32[i + 1] > t_q32[i]) ? t_q32[i + 1] - t_q32[i] : 0u;
+        if (dt > 0xFFFFFFFFu) dt = 0xFFFFFFFFu;
+        pll_q30_step_dt(st, x_q22[i], (uint32_t)dt);
+        if (out_f_q25) out_f_q25[i] = st->out_f_q25;
+    }
 }
+#endif
 
+// ---------- save / restore ----------
+#if PLL_API_SNAPSHOT
+static uint32_t snap_check(const pll_q30_snapshot_t *s)
+{
+    // FNV-1a over the header and payload words
+    uint32_t h = 2166136261u;
+    const uint32_t *p = &s->magic;
+    for (size_t i = 0; i < 2u + PLL_Q30_SNAP_WORDS; i++) {
+        uint32_t v = p[i];
+        for (int b = 0; b < 4; b++) { h ^= (v >> (8 * b)) & 0xFFu; h *= 16777619u; }
+    }
+    return h;
+}
+
+void pll_q30_save(const pll_q30_state_t *st, pll_q30_snapshot_t *snap)
+{
+    if (!st || !snap) return;
+    snap->magic   = PLL_Q30_SNAP_MAGIC;
+    snap->version = PLL_Q30_SNAP_VERSION;
+    snap->w[0] = (uint32_t)st->kp_q30;
+    snap->w[1] = (uint32_t)st->ki_q30;
+    snap->w[2] = st->theta_q30;
+    snap->w[3] = (uint32_t)st->integrator_q30;
+    snap->w[4] = (uint32_t)st->sin_q30;
+    snap->w[5] = (uint32_t)st->cos_q30;
+    snap->w[6] = (uint32_t)st->out_f_q25;
+    snap->w[7] = (uint32_t)st->delta_f_q25;
+    snap->w[8] = st->inv_fs_q40;
+    snap->check = snap_check(snap);
+}
+
+int pll_q30_restore(pll_q30_state_t *st, const pll_q30_snapshot_t *snap)
+{
+    if (!st || !snap) return -1;
+    if (snap->magic != PLL_Q30_SNAP_MAGIC || snap->version != PLL_Q30_SNAP_VERSION) return -1;
+    if (snap->check != snap_check(snap)) return -1;
+    if (snap->w[2] > 0x3FFFFFFFu) return -1;     // theta must be in [0, 1) turn
+    if (snap->w[8] == 0u) return -1;             // reciprocal of Fs
+
+    st->kp_q30         = (int32_t)snap->w[0];
+    st->ki_q30         = (int32_t)snap->w[1];
+    st->theta_q30      = snap->w[2];
+    st->integrator_q30 = (int32_t)snap->w[3];
+    st->sin_q30        = (int32_t)snap->w[4];
+    st->cos_q30        = (int32_t)snap->w[5];
+    st->out_f_q25      = (int32_t)snap->w[6];
+    st->delta_f_q25    = (int32_t)snap->w[7];
+    st->inv_fs_q40     = snap->w[8];
+    return 0;
+}
+#endif
 
 
 //int32_t pll_q30_step_hdl_io(pll_q30_state_t *st, int32_t x_q22)
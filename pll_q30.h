@@ -1,5 +1,6 @@
 #pragma once
 #include <stdint.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,12 +26,62 @@ typedef struct {
 
     // Optional: delta component (Hz) in Q25
     int32_t delta_f_q25;
+
+    // 1/Fs in seconds, Q0.40 (PLL_INV_FS_Q40 at init). pll_pps.h trims it to
+    // the measured sample rate; ignored when built with PLL_FS_TRIM=0.
+    uint32_t inv_fs_q40;
 } pll_q30_state_t;
 
-// Fs is compile-time for now (you can make it runtime if needed)
+// Fs is compile-time (PLL_FS_HZ); the reciprocal the step uses is in the state
 void pll_q30_init(pll_q30_state_t *st, int32_t kp_q30, int32_t ki_q30);
 void pll_q30_step(pll_q30_state_t *st, int32_t x_q22);
 
+// Block API: n samples in, optional out_f (Q25) per sample out (may be NULL).
+// Same result as n calls of pll_q30_step. Needs PLL_API_BLOCK.
+void pll_q30_step_block(pll_q30_state_t *st, const int32_t *x_q22, int32_t *out_f_q25, size_t n);
+
+// Non-uniform sampling: dt_q32 is the time from this sample to the next one,
+// seconds in Q0.32 (PLL_INV_FS_Q32 = the nominal 1/Fs, max ~1 s). The phase
+// increment becomes f * dt, so timestamp jitter no longer turns into
+// frequency error. The PI still runs once per sample (loop gains assume the
+// nominal spacing). pll_q30_step(st, x) == pll_q30_step_dt(st, x, PLL_INV_FS_Q32).
+// This and pll_q30_step_block_ts need PLL_API_TS.
+void pll_q30_step_dt(pll_q30_state_t *st, int32_t x_q22, uint32_t dt_q32);
+
+// Block API with timestamps, seconds in Q32.32 (any epoch): t_q32 holds n + 1
+// entries, t_q32[n] being the time of the sample after the block (the first
+// one of the next block), so a streaming caller holds back one sample.
+void pll_q30_step_block_ts(pll_q30_state_t *st, const int32_t *x_q22, const uint64_t *t_q32,
+                           int32_t *out_f_q25, size_t n);
+
+// Loop filter: the phase-detector output goes through a biquad cascade
+// (pll_biquad.h: notches at 2f/4f/6f, lead-lag, low-pass) before the PI;
+// otherwise pll_q30_step. The cascade state belongs to the caller and is not
+// part of the snapshot. Needs PLL_LOOP_FILTER (default; 0 in the minimal
+// profile).
+struct pll_bq_cascade;
+void pll_q30_step_lf(pll_q30_state_t *st, struct pll_bq_cascade *lf, int32_t x_q22);
+
+// State save/restore, e.g. across a warm restart of the soft core.
+// The snapshot is a versioned, checksummed word image of the state. Needs
+// PLL_API_SNAPSHOT.
+#define PLL_Q30_SNAP_MAGIC   0x50534E50u   // "PNSP"
+#define PLL_Q30_SNAP_VERSION 2u           // 2: + inv_fs_q40
+#define PLL_Q30_SNAP_WORDS   9u
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t w[PLL_Q30_SNAP_WORDS];
+    uint32_t check;
+} pll_q30_snapshot_t;
+
+void pll_q30_save(const pll_q30_state_t *st, pll_q30_snapshot_t *snap);
+// Returns 0 on success, -1 if the snapshot is corrupt, from another version,
+// or holds an out-of-range theta or a zero reciprocal. *st is untouched on
+// failure.
+int  pll_q30_restore(pll_q30_state_t *st, const pll_q30_snapshot_t *snap);
+
 int32_t pll_q30_step_hdl_io(pll_q30_state_t *st, int32_t x_q22);
 
 #ifdef __cplusplus
@@ -0,0 +1,64 @@
+#include "pll_q30w.h"
+#include "pll_config.h"
+#include "pll_sections.h"
+#include "pll_fixed.h"
+#include <stddef.h>
+
+#include "pll_nco.h"
+
+void pll_q30w_init(pll_q30w_state_t *st, int32_t kp_q30, int32_t ki_q30)
+{
+    if (!st) return;
+    *st = (pll_q30w_state_t){0};
+    st->kp_q30 = kp_q30;
+    st->ki_q30 = ki_q30;
+    st->out_f_q25 = (int32_t)(50 << 25);
+}
+
+PLL_HOT_TEXT void pll_q30w_step(pll_q30w_state_t *st, int32_t x_q22)
+{
+    const uint32_t INV_FS_Q32 = PLL_INV_FS_Q32;
+
+    // 1) NCO (same as pll_q30_step)
+#if PLL_NCO_QUARTER
+  #if PLL_OUT_COS
+    pll_nco_quarter_q30(st->theta_q30, &st->sin_q30, &st->cos_q30);
+  #else
+    st->sin_q30 = pll_nco_quarter_sin_q30(st->theta_q30);
+  #endif
+#else
+  #if PLL_OUT_COS
+    pll_nco_lut_q30(st->theta_q30, &st->sin_q30, &st->cos_q30);
+  #else
+    st->sin_q30 = pll_nco_lut_sin_q30(st->theta_q30);
+  #endif
+#endif
+
+    // 2)-3) Q22 -> Q30 and phase detector (same as pll_q30_step)
+    int32_t x_q30 = (int32_t)((uint32_t)x_q22 << PLL_X_SHIFT);
+    int32_t qerr_q30 = (int32_t)(0u - (uint32_t)pll_mul_q30(x_q30, st->sin_q30));
+
+    // 4) PI in 64 bits: |product >> 30| <= 2^32, no clamp needed. One clamp,
+    //    on the output; anti-windup by conditional integration: the new
+    //    integrator is kept unless the output saturates and i pushes further
+    //    into that rail (u and i of the same sign), which bounds the
+    //    integrator to |u| + |p| < 3 * 2^31
+    int64_t p_q30 = ((int64_t)st->kp_q30 * qerr_q30) >> 30;
+    int64_t i_q30 = ((int64_t)st->ki_q30 * qerr_q30) >> 30;
+    int64_t integ = st->integrator_q30 + i_q30;
+    int64_t u_sum = p_q30 + integ;
+    int32_t u_q30 = pll_sat32(u_sum);                                        // output clamp
+    if (u_sum == u_q30 || (u_sum ^ i_q30) < 0) st->integrator_q30 = integ;
+
+    // 5)-6) delta_f / out_f: u >> 5 always fits, no clamp
+    int32_t delta_f_q25 = u_q30 >> PLL_DF_SHIFT;
+#if PLL_OUT_DELTA
+    st->delta_f_q25 = delta_f_q25;
+#endif
+    int32_t f_q25 = (int32_t)(50 << 25) + delta_f_q25;
+    st->out_f_q25 = f_q25;
+
+    // 7) theta update (same as pll_q30_step)
+    int32_t phase_inc_q30 = (int32_t)(((int64_t)f_q25 * (int64_t)INV_FS_Q32) >> PLL_INC_SHIFT);
+    st->theta_q30 = pll_theta_add_q30(st->theta_q30, phase_inc_q30);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Wide-accumulator variant of pll_q30.
+//
+// Same loop, table, phase detector and I/O formats as pll_q30_step, but the
+// kp/ki products, the integrator and the PI sum are kept in 64 bits and
+// there is one clamp per sample, on the PI output. The HDL clamps the two
+// products, the integrator and the sum individually.
+//
+// Anti-windup is conditional integration: the integrator is frozen on the
+// samples where the output saturates and the ki term pushes further into
+// that rail, so it stays within |u| + |kp * qerr| < 3 * 2^31 (Q30) without
+// a clamp of its own. The PI output reaches only +-2 Hz around 50 Hz, so
+// that happens for any input outside 48..52 Hz; an integrator bounded only
+// by int64 would wind up there and hold out_f on the rail long after the
+// input returns.
+//
+// Equivalence: bit-exact with pll_q30_step (every state field) up to the
+// first sample on which one of the HDL's clamps engages; from there the
+// trajectories differ (host/engine_compare: a start-up pull-in that hits
+// the rails takes another path to the same frequency). host/fixed_verify.c and
+// host/fuzz_pll_q30.c check the equality up to there; fixed_verify also
+// checks that both re-lock after an out-of-range excursion.
+//
+// Cost: the integrator update is off the theta -> sin -> qerr -> out_f
+// chain; step_bench on host measures 20.0 cycles/sample against 21.4 for
+// pll_q30.
+
+typedef struct {
+    int32_t  kp_q30;
+    int32_t  ki_q30;
+    uint32_t theta_q30;       // turns, Q30, [0, 1)
+    int64_t  integrator_q30;  // Q30 in 64 bits, |.| < 3 * 2^31
+    int32_t  sin_q30;
+    int32_t  cos_q30;
+    int32_t  out_f_q25;       // Hz, Q25 (HDL Out_f)
+    int32_t  delta_f_q25;
+} pll_q30w_state_t;
+
+void pll_q30w_init(pll_q30w_state_t *st, int32_t kp_q30, int32_t ki_q30);
+void pll_q30w_step(pll_q30w_state_t *st, int32_t x_q22);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,67 @@
+#include "pll_range.h"
+
+// Instrumented builds only: nothing here ends up in the firmware otherwise.
+#if PLL_RANGE_INSTRUMENT
+
+// One sink per thread on the host; bare metal has a single context.
+#if defined(__linux__) || defined(_WIN32) || defined(__APPLE__)
+  #define PLL_RANGE_TLS _Thread_local
+#else
+  #define PLL_RANGE_TLS
+#endif
+
+static PLL_RANGE_TLS pll_range_t *cur;
+
+const char *const pll_range_name[PLL_RANGE_N] = {
+    "x_q30", "qerr_q30", "p_q30", "integrator_q30", "u_q30", "delta_f_q25", "phase_inc_q30",
+};
+
+void pll_range_reset(pll_range_t *r)
+{
+    if (!r) return;
+    for (int i = 0; i < PLL_RANGE_N; i++) {
+        r->min[i] = INT64_MAX;
+        r->max[i] = INT64_MIN;
+        r->sat[i] = 0;
+    }
+    r->samples = 0;
+}
+
+void pll_range_bind(pll_range_t *r)
+{
+    cur = r;
+}
+
+void pll_range_merge(pll_range_t *dst, const pll_range_t *src)
+{
+    if (!dst || !src) return;
+    for (int i = 0; i < PLL_RANGE_N; i++) {
+        if (src->min[i] < dst->min[i]) dst->min[i] = src->min[i];
+        if (src->max[i] > dst->max[i]) dst->max[i] = src->max[i];
+        dst->sat[i] += src->sat[i];
+    }
+    dst->samples += src->samples;
+}
+
+int pll_range_bits(const pll_range_t *r, int id)
+{
+    if (!r || id < 0 || id >= PLL_RANGE_N || r->min[id] > r->max[id]) return 0;
+    // smallest b with -2^(b-1) <= min and max <= 2^(b-1) - 1
+    int b = 1;
+    while (b < 64 && (r->min[id] < -((int64_t)1 << (b - 1)) ||
+                      r->max[id] >  ((int64_t)1 << (b - 1)) - 1))
+        b++;
+    return b;
+}
+
+void pll_range_rec(int id, int64_t computed, int32_t stored)
+{
+    pll_range_t *r = cur;
+    if (!r) return;
+    if (computed < r->min[id]) r->min[id] = computed;
+    if (computed > r->max[id]) r->max[id] = computed;
+    if (computed != (int64_t)stored) r->sat[id]++;
+    if (id == PLL_RANGE_X_Q30) r->samples++;
+}
+
+#endif // PLL_RANGE_INSTRUMENT
@@ -0,0 +1,60 @@
+#pragma once
+#include <stdint.h>
+
+#include "pll_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Range instrumentation of the pll_q30_step intermediates.
+//
+// Build the library with -DPLL_RANGE_INSTRUMENT=1: every probe then records
+// the value the step computes *before* it is clamped/wrapped to its 32-bit
+// format, so min/max show the real dynamic range and a saturation is counted
+// whenever the stored value differs from it. Without the flag the probes
+// expand to nothing and pll_q30_step is unchanged.
+//
+// Statistics go to the calling thread's sink (pll_range_bind), so several
+// threads can each run their own PLLs; merge the sinks afterwards.
+// host/range_scan.c runs this over capture files.
+
+typedef enum {
+    PLL_RANGE_X_Q30 = 0,      // input after Q22 -> Q30
+    PLL_RANGE_QERR_Q30,       // phase detector output
+    PLL_RANGE_P_Q30,          // kp * qerr
+    PLL_RANGE_INTEG_Q30,      // integrator after accumulate
+    PLL_RANGE_U_Q30,          // PI sum
+    PLL_RANGE_DELTA_F_Q25,    // u >> 5
+    PLL_RANGE_PHASE_INC_Q30,  // theta increment
+    PLL_RANGE_N
+} pll_range_id_t;
+
+typedef struct {
+    int64_t  min[PLL_RANGE_N];
+    int64_t  max[PLL_RANGE_N];
+    uint64_t sat[PLL_RANGE_N];   // samples where the stored value != computed
+    uint64_t samples;
+} pll_range_t;
+
+extern const char *const pll_range_name[PLL_RANGE_N];
+
+void pll_range_reset(pll_range_t *r);
+void pll_range_bind(pll_range_t *r);                        // NULL: stop recording
+void pll_range_merge(pll_range_t *dst, const pll_range_t *src);
+
+// Signed bits needed to hold [min, max] of one probe (0 if never recorded).
+// Headroom in a 32-bit word is 32 - bits (negative: the format overflowed).
+int  pll_range_bits(const pll_range_t *r, int id);
+
+void pll_range_rec(int id, int64_t computed, int32_t stored);
+
+#if PLL_RANGE_INSTRUMENT
+  #define PLL_RANGE_REC(id, computed, stored)  pll_range_rec((id), (computed), (stored))
+#else
+  #define PLL_RANGE_REC(id, computed, stored)  ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
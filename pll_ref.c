@@ -0,0 +1,84 @@
+#include "pll_ref.h"
+#include "pll_sections.h"
+#include "pll_nco.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+_Static_assert((PLL_REF_MAX % 8) == 0, "PLL_REF_MAX must be a multiple of 8");
+
+int pll_ref_init(pll_ref_set_t *set, const uint32_t *offsets_q30, uint32_t n)
+{
+    if (!set || n > PLL_REF_MAX) return -1;
+    set->n = n;
+    for (uint32_t k = 0; k < PLL_REF_MAX; k++)
+        set->offset_q30[k] = (offsets_q30 && k < n) ? offsets_q30[k] & 0x3FFFFFFFu : 0u;
+    return 0;
+}
+
+void pll_ref_set_offset(pll_ref_set_t *set, uint32_t k, uint32_t offset_q30)
+{
+    if (!set || k >= PLL_REF_MAX) return;
+    set->offset_q30[k] = offset_q30 & 0x3FFFFFFFu;
+}
+
+#if defined(__AVX2__)
+// a + ((b - a) * frac) >> 20 per lane: 64-bit products on even/odd lanes.
+// The low 32 bits of a logical and an arithmetic >> 20 agree, and the
+// result fits 32 bits, so no 64-bit arithmetic shift is needed.
+static inline __m256i interp8(__m256i a, __m256i b, __m256i frac)
+{
+    __m256i d  = _mm256_sub_epi32(b, a);
+    __m256i pe = _mm256_srli_epi64(_mm256_mul_epi32(d, frac), 20);
+    __m256i po = _mm256_srli_epi64(_mm256_mul_epi32(_mm256_srli_epi64(d, 32), _mm256_srli_epi64(frac, 32)), 20);
+    __m256i r  = _mm256_blend_epi32(pe, _mm256_slli_epi64(po, 32), 0xAA);
+    return _mm256_add_epi32(a, r);
+}
+
+static void eval8(const uint32_t *off, uint32_t theta_q30, int32_t *s_q30, int32_t *c_q30)
+{
+    const __m256i mask_t = _mm256_set1_epi32(0x3FFFFFFF);
+    const __m256i mask_i = _mm256_set1_epi32(SINE_N - 1);
+    const __m256i mask_f = _mm256_set1_epi32((1 << 20) - 1);
+    const __m256i one    = _mm256_set1_epi32(1);
+    const __m256i qtr    = _mm256_set1_epi32(SINE_N / 4);
+    const int *tab = (const int *)sine_q230;
+
+    __m256i t    = _mm256_and_si256(_mm256_add_epi32(_mm256_set1_epi32((int)theta_q30),
+                                                     _mm256_loadu_si256((const __m256i *)off)), mask_t);
+    __m256i frac = _mm256_and_si256(t, mask_f);
+    __m256i is   = _mm256_srli_epi32(t, 20);
+    __m256i ic   = _mm256_and_si256(_mm256_add_epi32(is, qtr), mask_i);
+    __m256i sa = _mm256_i32gather_epi32(tab, is, 4);
+    __m256i sb = _mm256_i32gather_epi32(tab, _mm256_and_si256(_mm256_add_epi32(is, one), mask_i), 4);
+    __m256i ca = _mm256_i32gather_epi32(tab, ic, 4);
+    __m256i cb = _mm256_i32gather_epi32(tab, _mm256_and_si256(_mm256_add_epi32(ic, one), mask_i), 4);
+    _mm256_storeu_si256((__m256i *)s_q30, interp8(sa, sb, frac));
+    _mm256_storeu_si256((__m256i *)c_q30, interp8(ca, cb, frac));
+}
+#endif
+
+PLL_HOT_TEXT void pll_ref_eval(const pll_ref_set_t *set, uint32_t theta_q30, int32_t *s_q30, int32_t *c_q30)
+{
+    if (!set || !s_q30 || !c_q30) return;
+#if defined(__AVX2__)
+    int32_t s[8], c[8];
+    for (uint32_t k = 0; k < set->n; k += 8) {
+        uint32_t m = (set->n - k < 8) ? set->n - k : 8;
+        eval8(&set->offset_q30[k], theta_q30, s, c);
+        for (uint32_t j = 0; j < m; j++) { s_q30[k + j] = s[j]; c_q30[k + j] = c[j]; }
+    }
+#else
+    for (uint32_t k = 0; k < set->n; k++) {
+        uint32_t t    = (theta_q30 + set->offset_q30[k]) & 0x3FFFFFFFu;
+        uint32_t idx  = t >> 20;
+        int32_t  frac = (int32_t)(t & ((1u << 20) - 1));
+        int32_t  sa = sine_q230[idx], sb = sine_q230[(idx + 1) & (SINE_N - 1)];
+        uint32_t ic = (idx + SINE_N / 4) & (SINE_N - 1);
+        int32_t  ca = sine_q230[ic], cb = sine_q230[(ic + 1) & (SINE_N - 1)];
+        s_q30[k] = sa + (int32_t)(((int64_t)(sb - sa) * frac) >> 20);
+        c_q30[k] = ca + (int32_t)(((int64_t)(cb - ca) * frac) >> 20);
+    }
+#endif
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <stdint.h>
+
+#include "pll_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Phase-shifted sin/cos references from one theta (three-phase +-120 deg,
+// quadrature, delay compensation, ...).
+//
+// Per reference k: t = theta + offset[k], split once into the 10-bit table
+// index and the 20-bit fraction. sin interpolates sine_q230[i], [i + 1];
+// cos is a quarter turn on, i.e. index + 256 with the same fraction, so both
+// outputs of a reference share one index/fraction split and no further
+// table walk. Results are bit-exact with pll_nco_interp_q30(theta + offset)
+// (30-bit phase, ~60 dB lower spurs than the plain LUT).
+//
+// Offsets on the 1/1024-turn grid (90, 180 deg) only move the index; others
+// (120 deg is 341.33 steps) add their fraction to theta's, with the carry
+// into the index. A delay of d samples is compensated with the offset
+// pll_phase_inc_q30(st) * d (pll_phase.h), updated at run time with
+// pll_ref_set_offset().
+//
+// All references are computed in one pass. On host the pass is 8 lanes wide
+// with AVX2 (gathers from the table, 32x32->64 products; build with -mavx2),
+// bit-exact with the scalar path.
+
+#ifndef PLL_REF_MAX
+#define PLL_REF_MAX 8               // references per set, multiple of 8 for AVX2
+#endif
+
+// integer degrees -> Q30 turns (negative: mod 1 turn)
+#define PLL_REF_DEG_Q30(d) \
+    ((uint32_t)(((((int64_t)(d) % 360 + 360) % 360) * (1ll << 30) + 180) / 360) & 0x3FFFFFFFu)
+
+typedef struct {
+    uint32_t n;
+    uint32_t offset_q30[PLL_REF_MAX];
+} pll_ref_set_t;
+
+// Returns 0, or -1 if n > PLL_REF_MAX. offsets_q30 may be NULL (all 0).
+int  pll_ref_init(pll_ref_set_t *set, const uint32_t *offsets_q30, uint32_t n);
+void pll_ref_set_offset(pll_ref_set_t *set, uint32_t k, uint32_t offset_q30);
+
+// s_q30[k], c_q30[k] for k < set->n (Q2.30)
+void pll_ref_eval(const pll_ref_set_t *set, uint32_t theta_q30, int32_t *s_q30, int32_t *c_q30);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,195 @@
+#include "pll_resamp.h"
+#include "pll_sections.h"
+
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+_Static_assert((PLL_RS_QN & (PLL_RS_QN - 1u)) == 0, "PLL_RS_QN must be 2^k");
+_Static_assert(PLL_RS_MAX_SPC < (1u << 15), "positions are Q16 in 32 bits");
+
+#define ONE_Q30   (1 << 30)
+#define INV3_Q30  357913941             // 1/3
+#define INV6_Q30  178956971             // 1/6
+
+// ---------- ordering helpers (as in pll_mailbox.c) ----------
+static inline uint32_t ld_acq(const uint32_t *p)      { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+static inline uint32_t ld_rlx(const uint32_t *p)      { return __atomic_load_n(p, __ATOMIC_RELAXED); }
+static inline void     st_rel(uint32_t *p, uint32_t v) { __atomic_store_n(p, v, __ATOMIC_RELEASE); }
+
+// ---------- kernel ----------
+// Every product is (a * b) >> 30 kept to 32 bits; all intermediates are in
+// range, so the SIMD path can use logical 64-bit shifts and the low halves.
+static inline int32_t mulq(int32_t a, int32_t b)
+{
+    return (int32_t)(((int64_t)a * b) >> 30);
+}
+
+static inline int32_t interp1(const int32_t *x, int32_t u)
+{
+    int32_t w    = (u >> 1) - ONE_Q30;                  // (u - 2) / 2
+    int32_t up1  = u + ONE_Q30;
+    int32_t p    = mulq(u, u - ONE_Q30);                // u (u - 1)
+    int32_t cm1  = -mulq(mulq(p, w), INV3_Q30);
+    int32_t c0   = mulq(mulq(u, u) - ONE_Q30, w);
+    int32_t c1   = -mulq(mulq(u, up1), w);
+    int32_t c2   = mulq(mulq(up1, p), INV6_Q30);
+    int64_t acc  = (int64_t)cm1 * x[-1] + (int64_t)c0 * x[0] + (int64_t)c1 * x[1] + (int64_t)c2 * x[2];
+    return (int32_t)(acc >> 30);
+}
+
+#if defined(__SSE4_1__)
+// two points, one per 64-bit lane (value in the low 32 bits)
+static inline __m128i mulq2(__m128i a, __m128i b)
+{
+    return _mm_srli_epi64(_mm_mul_epi32(a, b), 30);
+}
+
+static void interp_sse41(const int32_t *x, const uint32_t *pos, const int32_t *u_q30, int32_t *out, size_t n)
+{
+    const __m128i one  = _mm_set1_epi64x(ONE_Q30);
+    const __m128i inv3 = _mm_set1_epi64x(INV3_Q30);
+    const __m128i inv6 = _mm_set1_epi64x(INV6_Q30);
+    const __m128i zero = _mm_setzero_si128();
+    size_t k = 0;
+    for (; k + 2 <= n; k += 2) {
+        const int32_t *x0 = x + pos[k], *x1 = x + pos[k + 1];
+        __m128i u   = _mm_set_epi32(0, u_q30[k + 1], 0, u_q30[k]);
+        __m128i w   = _mm_sub_epi32(_mm_srai_epi32(u, 1), one);
+        __m128i up1 = _mm_add_epi32(u, one);
+        __m128i p   = mulq2(u, _mm_sub_epi32(u, one));
+        __m128i cm1 = _mm_sub_epi32(zero, mulq2(mulq2(p, w), inv3));
+        __m128i c0  = mulq2(_mm_sub_epi32(mulq2(u, u), one), w);
+        __m128i c1  = _mm_sub_epi32(zero, mulq2(mulq2(u, up1), w));
+        __m128i c2  = mulq2(mulq2(up1, p), inv6);
+        __m128i acc = _mm_mul_epi32(cm1, _mm_set_epi32(0, x1[-1], 0, x0[-1]));
+        acc = _mm_add_epi64(acc, _mm_mul_epi32(c0, _mm_set_epi32(0, x1[0], 0, x0[0])));
+        acc = _mm_add_epi64(acc, _mm_mul_epi32(c1, _mm_set_epi32(0, x1[1], 0, x0[1])));
+        acc = _mm_add_epi64(acc, _mm_mul_epi32(c2, _mm_set_epi32(0, x1[2], 0, x0[2])));
+        acc = _mm_shuffle_epi32(_mm_srli_epi64(acc, 30), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm_storel_epi64((__m128i *)&out[k], acc);
+    }
+    for (; k < n; k++) out[k] = interp1(x + pos[k], u_q30[k]);
+}
+#endif
+
+void pll_rs_interp(const int32_t *x, const uint32_t *pos, const int32_t *u_q30, int32_t *out, size_t n)
+{
+    if (!x || !pos || !u_q30 || !out) return;
+#if defined(__SSE4_1__)
+    interp_sse41(x, pos, u_q30, out, n);
+#else
+    for (size_t k = 0; k < n; k++) out[k] = interp1(x + pos[k], u_q30[k]);
+#endif
+}
+
+// ---------- producer ----------
+void pll_rs_init(pll_rs_t *rs)
+{
+    if (!rs) return;
+    rs->zc.inc_q30 = 0;
+    rs->zc.recip_q50 = 0;
+    rs->theta_prev = 0;
+    rs->have_prev = rs->in_cycle = rs->pending = 0;
+    rs->t0_q16 = rs->t1_q16 = 0;
+    rs->buf_n = 0;
+    rs->cycle = rs->dropped = rs->overruns = 0;
+    rs->head = 0;
+    st_rel(&rs->tail, 0);
+}
+
+// keep buffer samples from `first` on (positions move down with them)
+static void rebase(pll_rs_t *rs, uint32_t first)
+{
+    uint32_t m = rs->buf_n - first;
+    for (uint32_t i = 0; i < m; i++) rs->buf[i] = rs->buf[first + i];
+    rs->buf_n = m;
+    rs->t0_q16 -= first << 16;
+}
+
+static int emit(pll_rs_t *rs)
+{
+    uint32_t head = rs->head;
+    uint32_t tail = ld_acq(&rs->tail);
+    rs->cycle++;
+    if ((uint32_t)(head - tail) >= PLL_RS_QN) {
+        rs->dropped++;
+        return -1;
+    }
+
+    pll_rs_block_t *b = &rs->q[head & (PLL_RS_QN - 1u)];
+    uint64_t T = rs->t1_q16 - rs->t0_q16;
+    for (uint32_t j = 0; j < PLL_RS_N; j++) {
+        uint32_t t = rs->t0_q16 + (uint32_t)((T * j) >> PLL_RS_LOG2N);
+        rs->pos[j]   = t >> 16;
+        rs->u_q30[j] = (int32_t)((t & 0xFFFFu) << 14);
+    }
+    pll_rs_interp(rs->buf, rs->pos, rs->u_q30, b->x_q22, PLL_RS_N);
+    b->cycle = rs->cycle;
+    b->period_q16 = (uint32_t)T;
+
+    st_rel(&rs->head, head + 1u);           // block visible before the index
+    return 1;
+}
+
+PLL_HOT_TEXT int pll_rs_push(pll_rs_t *rs, int32_t x_q22, uint32_t theta_q30)
+{
+    int rc = 0;
+    theta_q30 &= 0x3FFFFFFFu;
+    rs->buf[rs->buf_n++] = x_q22;
+
+    // the closed cycle's last point has its x[a + 2] now
+    if (rs->pending) {
+        rs->pending = 0;
+        rc = emit(rs);
+        rs->t0_q16 = rs->t1_q16;
+    }
+
+    if (rs->have_prev) {
+        uint32_t inc = (theta_q30 - rs->theta_prev) & 0x3FFFFFFFu;
+        uint32_t to0 = (0u - rs->theta_prev) & 0x3FFFFFFFu;        // phase left to the wrap
+        int valid = pll_zc_set_inc(&rs->zc, (int32_t)inc) == 0;
+        if (!valid) {
+            if (rs->in_cycle) rs->overruns++;
+            rs->in_cycle = 0;
+        } else if (to0 < inc) {
+            // boundary between the previous sample (buf_n - 2) and this one
+            uint32_t t = ((rs->buf_n - 2u) << 16) + pll_zc_time_q16(&rs->zc, rs->theta_prev, 0);
+            if (rs->in_cycle) {
+                rs->t1_q16 = t;
+                rs->pending = 1;
+            } else if (rs->buf_n >= 3) {            // x[a - 1] must exist
+                rs->t0_q16 = t;
+                rs->in_cycle = 1;
+            }
+        }
+    }
+    rs->theta_prev = theta_q30;
+    rs->have_prev = 1;
+
+    if (!rs->in_cycle) {
+        if (rs->buf_n >= 64) rebase(rs, rs->buf_n - 3);
+    } else if (!rs->pending) {
+        uint32_t first = (rs->t0_q16 >> 16) - 1u;                   // x[a - 1] of the first point
+        if (first) rebase(rs, first);
+        if (rs->buf_n >= PLL_RS_MAX_SPC) {
+            rs->overruns++;
+            rs->in_cycle = 0;
+        }
+    }
+    return rc;
+}
+
+// ---------- consumer ----------
+const pll_rs_block_t *pll_rs_peek(pll_rs_t *rs)
+{
+    uint32_t tail = ld_rlx(&rs->tail);
+    if (tail == ld_acq(&rs->head)) return NULL;
+    return &rs->q[tail & (PLL_RS_QN - 1u)];
+}
+
+void pll_rs_release(pll_rs_t *rs)
+{
+    uint32_t tail = ld_rlx(&rs->tail);
+    if (tail != ld_acq(&rs->head)) st_rel(&rs->tail, tail + 1u);   // slot free only after use
+}
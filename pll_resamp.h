@@ -0,0 +1,104 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+#include "pll_config.h"
+#include "pll_q30.h"
+#include "pll_phase.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Grid-synchronous resampling: PLL_RS_N points per grid cycle, for plain
+// (rectangular, leakage-free) FFTs of each cycle on an analysis thread.
+//
+// Cycle boundaries are where theta wraps, located to 1/65536 sample from
+// the increment (pll_zc_t reciprocal, no divide); the N points of a cycle
+// are spaced uniformly in time between two boundaries. Placing them on
+// theta itself would carry the loop's in-cycle phase ripple (2f) into the
+// grid; uniform spacing only needs the cycle length to be right. Each point
+// is a 4-tap cubic Lagrange interpolation (u = position within the sample
+// interval):
+//   y = c-1 x[a-1] + c0 x[a] + c1 x[a+1] + c2 x[a+2]
+//   c-1 = -u (u-1)(u-2)/6   c0 = (u+1)(u-1)(u-2)/2
+//   c1  = -(u+1) u (u-2)/2  c2 = (u+1) u (u-1)/6
+// with Q30 coefficients and a 64-bit sum. On host the kernel is 2 points
+// per SSE4.1 register (32x32->64 products; build with -msse4.1 or
+// -march=native), bit-exact with the scalar path.
+//
+// A finished cycle goes into a single-producer / single-consumer lock-free
+// queue of PLL_RS_QN blocks: the sampling context pushes, the analysis
+// thread peeks and releases. A full queue drops the block (the producer
+// never blocks) and counts it. The interpolation runs once per cycle, at
+// the sample after the closing boundary (the last point needs x[a+2]).
+//
+// Limits: PLL_RS_N must stay below the samples per cycle (Fs/f); a cycle
+// longer than PLL_RS_MAX_SPC samples (loop not locked) is abandoned and
+// counted. Outputs are exact (no saturation) for |x| < 2^30 / 1.25.
+
+#ifndef PLL_RS_LOG2N
+#define PLL_RS_LOG2N     8                      // 256 points per cycle
+#endif
+#define PLL_RS_N         (1u << PLL_RS_LOG2N)
+#ifndef PLL_RS_QN
+#define PLL_RS_QN        4u                     // queued blocks, power of two
+#endif
+#ifndef PLL_RS_MAX_SPC
+#define PLL_RS_MAX_SPC   2048u                  // input samples per cycle (20 Hz at 40 kHz)
+#endif
+
+typedef struct {
+    uint32_t cycle;                // producer cycle counter (gaps => drops)
+    uint32_t period_q16;           // cycle length, input samples Q16: f = Fs * 2^16 / period
+    int32_t  x_q22[PLL_RS_N];
+} pll_rs_block_t;
+
+typedef struct {
+    // ---- producer ----
+    pll_zc_t  zc;                  // 2^50 / increment for the boundary position
+    uint32_t  theta_prev;
+    int       have_prev;
+    int       in_cycle;            // a boundary has been seen, t0 is valid
+    int       pending;             // cycle closed, emitted at the next sample
+    uint32_t  t0_q16, t1_q16;      // boundaries, buffer samples Q16
+    uint32_t  buf_n;
+    int32_t   buf[PLL_RS_MAX_SPC + 4];
+    uint32_t  pos[PLL_RS_N];
+    int32_t   u_q30[PLL_RS_N];
+    uint32_t  cycle;
+    uint32_t  dropped;             // blocks lost to a full queue
+    uint32_t  overruns;            // cycles abandoned (too long, no valid rate)
+    uint32_t  head;                // next slot to write (free-running)
+    uint8_t   _pad0[64];
+
+    // ---- consumer ----
+    uint32_t  tail;                // next slot to read (free-running)
+    uint8_t   _pad1[64];
+
+    pll_rs_block_t q[PLL_RS_QN];
+} pll_rs_t;
+
+void pll_rs_init(pll_rs_t *rs);
+
+// x_q22: the input sample, theta_q30: its phase. Returns 1 when a block
+// was queued, -1 when one was dropped, 0 otherwise.
+int  pll_rs_push(pll_rs_t *rs, int32_t x_q22, uint32_t theta_q30);
+
+// After pll_q30_step(st, x): the phase of x is theta before the step.
+static inline int pll_rs_step(pll_rs_t *rs, const pll_q30_state_t *st, int32_t x_q22)
+{
+    return pll_rs_push(rs, x_q22, (st->theta_q30 - (uint32_t)pll_phase_inc_q30(st)) & 0x3FFFFFFFu);
+}
+
+// Consumer: oldest queued block or NULL; pll_rs_release() frees it.
+const pll_rs_block_t *pll_rs_peek(pll_rs_t *rs);
+void pll_rs_release(pll_rs_t *rs);
+
+// The interpolation kernel: out[k] at x[pos[k] + u_q30[k] / 2^30], taps
+// x[pos[k] - 1 .. pos[k] + 2].
+void pll_rs_interp(const int32_t *x, const uint32_t *pos, const int32_t *u_q30, int32_t *out, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
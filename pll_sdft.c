@@ -0,0 +1,123 @@
+#include "pll_sdft.h"
+#include "pll_sections.h"
+#include "pll_fixed.h"
+#include "pll_nco.h"
+
+_Static_assert(PLL_SDFT_NB == PLL_REF_MAX, "one pll_ref set holds the bank's twiddles");
+_Static_assert(PLL_SDFT_LOG2M >= 6 && PLL_SDFT_LOG2M <= 16, "PLL_SDFT_LOG2M out of range");
+_Static_assert(PLL_SDFT_K_LO >= 1 && PLL_SDFT_K_LO < PLL_SDFT_M / 2 - PLL_SDFT_NB,
+               "PLL_SDFT_F_NOM_HZ needs M >= 4 Fs / f_nom (raise PLL_SDFT_LOG2M)");
+
+#define HIST_SHIFT  8               // Q22 -> Q14
+
+int pll_sdft_init(pll_sdft_t *b, uint32_t k_lo)
+{
+    if (!b || k_lo < 1 || k_lo >= PLL_SDFT_M / 2 - PLL_SDFT_NB) return -1;
+    pll_ref_init(&b->tw, NULL, PLL_SDFT_NB);
+    b->k_lo = k_lo;
+    b->pos = 0;
+    b->filled = 0;
+    b->loop_sum = 0;
+    b->loop_f_q25 = 0;
+    for (uint32_t ch = 0; ch < PLL_SDFT_CH; ch++) {
+        for (uint32_t j = 0; j < PLL_SDFT_NB; j++) b->re[ch][j] = b->im[ch][j] = 0;
+        for (uint32_t i = 0; i < PLL_SDFT_M; i++) b->hist[ch][i] = 0;
+    }
+    return 0;
+}
+
+PLL_HOT_TEXT void pll_sdft_step(pll_sdft_t *b, const int32_t x_q22[PLL_SDFT_CH])
+{
+    if (!b || !x_q22) return;
+    int32_t s[PLL_SDFT_NB], c[PLL_SDFT_NB];
+    pll_ref_eval(&b->tw, 0, s, c);              // e^(j 2 pi k n / M), n = pos
+
+    for (uint32_t ch = 0; ch < PLL_SDFT_CH; ch++) {
+        int16_t x = pll_sat16(x_q22[ch] >> HIST_SHIFT);
+        int32_t d = (int32_t)x - b->hist[ch][b->pos];
+        b->hist[ch][b->pos] = x;
+        for (uint32_t j = 0; j < PLL_SDFT_NB; j++) {
+            b->re[ch][j] += (int64_t)d * c[j];
+            b->im[ch][j] -= (int64_t)d * s[j];
+        }
+    }
+
+    // next sample's twiddles: k 2^30 / M per sample, exact in Q30
+    for (uint32_t j = 0; j < PLL_SDFT_NB; j++)
+        b->tw.offset_q30[j] = (b->tw.offset_q30[j] + ((b->k_lo + j) << (30 - PLL_SDFT_LOG2M))) & 0x3FFFFFFFu;
+    b->pos = (b->pos + 1u) & (PLL_SDFT_M - 1u);
+    if (b->filled < PLL_SDFT_M) b->filled++;
+}
+
+static uint32_t isqrt64(uint64_t v)
+{
+    uint64_t r = 0, bit = (uint64_t)1 << 62;
+    while (bit > v) bit >>= 2;
+    while (bit) {
+        if (v >= r + bit) {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)r;
+}
+
+static inline uint64_t abs64(int64_t v) { return v < 0 ? 0u - (uint64_t)v : (uint64_t)v; }
+
+int pll_sdft_freq(const pll_sdft_t *b, uint32_t ch, int32_t *f_q25)
+{
+    if (!b || !f_q25 || ch >= PLL_SDFT_CH || b->filled < PLL_SDFT_M) return -1;
+
+    // scale the bank so the largest component is in [2^29, 2^30)
+    int64_t ar[PLL_SDFT_NB], ai[PLL_SDFT_NB];
+    uint64_t mx = 0;
+    for (uint32_t j = 0; j < PLL_SDFT_NB; j++) mx |= abs64(b->re[ch][j]) | abs64(b->im[ch][j]);
+    if (!mx) return -1;
+    int sh = 63 - __builtin_clzll(mx) - 29;     // > 0: shift down
+    for (uint32_t j = 0; j < PLL_SDFT_NB; j++) {
+        ar[j] = sh > 0 ? b->re[ch][j] >> sh : (int64_t)((uint64_t)b->re[ch][j] << -sh);
+        ai[j] = sh > 0 ? b->im[ch][j] >> sh : (int64_t)((uint64_t)b->im[ch][j] << -sh);
+    }
+
+    // Hann bins 1..NB-2 (x2), window start n0 = pos: neighbours rotated by
+    // e^(-+j 2 pi n0 / M)
+    int32_t sp, cp;
+    pll_nco_interp_q30(b->pos << (30 - PLL_SDFT_LOG2M), &sp, &cp);
+    int64_t hr[PLL_SDFT_NB], hi[PLL_SDFT_NB];
+    uint64_t m2[PLL_SDFT_NB];
+    uint32_t pk = 1;
+    for (uint32_t j = 1; j + 1 < PLL_SDFT_NB; j++) {
+        int64_t lr = (ar[j - 1] * cp + ai[j - 1] * sp) >> 30;        // A_k-1 e^(-j phi)
+        int64_t li = (ai[j - 1] * cp - ar[j - 1] * sp) >> 30;
+        int64_t ur = (ar[j + 1] * cp - ai[j + 1] * sp) >> 30;        // A_k+1 e^(+j phi)
+        int64_t ui = (ai[j + 1] * cp + ar[j + 1] * sp) >> 30;
+        hr[j] = ar[j] - ((lr + ur) >> 1);
+        hi[j] = ai[j] - ((li + ui) >> 1);
+        m2[j] = (uint64_t)(hr[j] * hr[j]) + (uint64_t)(hi[j] * hi[j]);
+        if (m2[j] > m2[pk]) pk = j;
+    }
+    if (pk < 2 || pk + 2 >= PLL_SDFT_NB) return -1;
+
+    int up = m2[pk + 1] >= m2[pk - 1];
+    uint32_t bm = isqrt64(m2[pk]);
+    uint32_t am = isqrt64(m2[up ? pk + 1 : pk - 1]);
+    while (bm >= (1u << 29)) { bm >>= 1; am >>= 1; }
+    if (!bm) return -1;
+
+    // delta = (2a - b) / (a + b), |delta| <= 1, Q16 by long division
+    uint32_t den = am + bm;
+    int neg = 2 * am < bm;
+    uint32_t r = neg ? bm - 2 * am : 2 * am - bm, q = 0;
+    for (int i = 0; i < 17; i++) {
+        q <<= 1;
+        if (r >= den) { r -= den; q |= 1u; }
+        r <<= 1;
+    }
+    int64_t d_q16 = (neg != !up) ? -(int64_t)q : (int64_t)q;
+    int64_t bin_q16 = ((int64_t)(b->k_lo + pk) << 16) + d_q16;
+    *f_q25 = pll_sat32(((bin_q16 * PLL_FS_HZ) << 9) >> PLL_SDFT_LOG2M);
+    return 0;
+}
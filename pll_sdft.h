@@ -0,0 +1,105 @@
+#pragma once
+#include <stdint.h>
+
+#include "pll_config.h"
+#include "pll_q30.h"
+#include "pll_ref.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Sliding-DFT frequency monitor: an estimate independent of the loop, to
+// cross-check out_f_q25 for supervision.
+//
+// PLL_SDFT_NB consecutive bins k_lo .. k_lo + NB - 1 of an M-point DFT
+// (M = 2^PLL_SDFT_LOG2M, bin spacing Fs / M) are kept for PLL_SDFT_CH
+// channels and updated every sample, O(1) per bin:
+//   A_k += (x[n] - x[n - M]) * e^(-j 2 pi k n / M)
+// The twiddle of a sample is a function of n mod M only, so the product
+// subtracted M samples later is bit-identical to the one added: the 64-bit
+// sums are exact, with no drift and no recursive rotation. The twiddles
+// come from a pll_ref set whose offsets advance by k 2^30 / M per sample
+// (the interpolated sine table, AVX2 on host). The update loop over bins
+// vectorizes on host (-O3, 32x32->64 products: AVX2 vpmuldq).
+//
+// The delay line holds the input as Q14 int16 (x_q22 >> 8, saturated at
+// +-2 pu): M * CH * 2 bytes, 24 KB for the defaults.
+//
+// pll_sdft_freq() (on demand, not per sample): a Hann window is applied in
+// the frequency domain, H_k = A_k / 2 - (A_k-1 + A_k+1) / 4 with the
+// window-start rotation, the peak Hann bin is located and interpolated
+// from its larger neighbour (a) and itself (b):
+//   delta = +-(2a - b) / (a + b)       exact for a tone under a Hann window
+// f = (k + delta) Fs / M. Magnitudes are integer square roots and the
+// ratio a 17-step long division: no divide instruction, no float. The
+// negative-frequency image and harmonics leak in through the Hann
+// sidelobes; at the defaults (10 Hz bins, 50 Hz) the estimate is within
+// a few mHz of the input, independent of the loop's 2f ripple.
+
+#ifndef PLL_SDFT_LOG2M
+#define PLL_SDFT_LOG2M     12                   // 4096 samples: 0.1 s, 9.77 Hz bins at 40 kHz
+#endif
+#define PLL_SDFT_M         (1u << PLL_SDFT_LOG2M)
+#define PLL_SDFT_NB        8u                   // bins, = PLL_REF_MAX
+#ifndef PLL_SDFT_CH
+#define PLL_SDFT_CH        3u
+#endif
+#ifndef PLL_SDFT_F_NOM_HZ
+#define PLL_SDFT_F_NOM_HZ  50
+#endif
+// nominal frequency in bin 3 of the bank (peak usable in bins 2..5)
+#define PLL_SDFT_K_LO \
+    ((uint32_t)(((uint64_t)PLL_SDFT_F_NOM_HZ * PLL_SDFT_M + PLL_FS_HZ / 2) / PLL_FS_HZ) - 3u)
+
+typedef struct {
+    pll_ref_set_t tw;                           // offsets: phase of each bin at sample n
+    uint32_t k_lo;
+    uint32_t pos;                               // n mod M: next slot, oldest sample
+    uint32_t filled;                            // samples in the window, saturates at M
+    int64_t  loop_sum;                          // pll_sdft_step_st: out_f_q25 over the block
+    int32_t  loop_f_q25;                        // mean out_f_q25 of the last complete block
+    int64_t  re[PLL_SDFT_CH][PLL_SDFT_NB];
+    int64_t  im[PLL_SDFT_CH][PLL_SDFT_NB];
+    int16_t  hist[PLL_SDFT_CH][PLL_SDFT_M];
+} pll_sdft_t;
+
+// k_lo >= 1 and k_lo + NB < M / 2; -1 otherwise.
+int  pll_sdft_init(pll_sdft_t *b, uint32_t k_lo);
+
+// One sample per channel, x_q22[ch].
+void pll_sdft_step(pll_sdft_t *b, const int32_t x_q22[PLL_SDFT_CH]);
+
+// Frequency of channel ch, Hz Q25 like out_f_q25. -1 (f untouched) until the
+// window is full, on a zero input, or when the peak is at the edge of the
+// bank (off-nominal by more than about 2 bins).
+int  pll_sdft_freq(const pll_sdft_t *b, uint32_t ch, int32_t *f_q25);
+
+// With the loop: also averages out_f_q25 over the same M samples as the DFT
+// window (aligned blocks, pos == 0). Returns 1 when a block completed and
+// loop_f_q25 is its mean, the moment to call pll_sdft_check().
+static inline int pll_sdft_step_st(pll_sdft_t *b, const pll_q30_state_t *st, const int32_t x_q22[PLL_SDFT_CH])
+{
+    pll_sdft_step(b, x_q22);
+    b->loop_sum += st->out_f_q25;
+    if (b->pos) return 0;
+    b->loop_f_q25 = (int32_t)(b->loop_sum >> PLL_SDFT_LOG2M);
+    b->loop_sum = 0;
+    return 1;
+}
+
+// Cross-check of the loop's mean frequency over the window against the
+// estimate of channel ch: 1 if they differ by more than tol_q25, 0 if
+// within, -1 if there is no estimate. The loop's 2f ripple averages out over
+// the window; comparing the instantaneous out_f_q25 would not.
+static inline int pll_sdft_check(const pll_sdft_t *b, uint32_t ch, int32_t tol_q25)
+{
+    int32_t f;
+    if (pll_sdft_freq(b, ch, &f) != 0) return -1;
+    int64_t d = (int64_t)b->loop_f_q25 - f;
+    return (d > tol_q25 || d < -(int64_t)tol_q25) ? 1 : 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,34 @@
+#pragma once
+
+// Placement of the PLL hot path (step function, helpers, NCO tables).
+//
+// Default: normal .text/.rodata, wherever the linker script puts them.
+// -DPLL_USE_TCM: code goes to PLL_TCM_TEXT_SECTION and tables to
+// PLL_TCM_RODATA_SECTION, which pll_tcm.ld maps into local memory (LMB/TCM)
+// so timing no longer depends on the caches and the AXI path.
+// Without the linker fragment the sections are orphans and GNU ld places them
+// next to .text/.rodata, i.e. it falls back to normal placement.
+
+#if defined(PLL_USE_TCM)
+  #ifndef PLL_TCM_TEXT_SECTION
+    #define PLL_TCM_TEXT_SECTION    ".tcm_text"
+  #endif
+  #ifndef PLL_TCM_RODATA_SECTION
+    #define PLL_TCM_RODATA_SECTION  ".tcm_rodata"
+  #endif
+  #define PLL_HOT_TEXT    __attribute__((section(PLL_TCM_TEXT_SECTION)))
+  #define PLL_HOT_RODATA  __attribute__((section(PLL_TCM_RODATA_SECTION)))
+#else
+  #define PLL_HOT_TEXT
+  #define PLL_HOT_RODATA
+#endif
+
+// Shared step bodies (fixed-rate and timestamped entry points): inlined into
+// each entry point so the fixed-rate step keeps its constant reciprocal. At
+// -Os (MINIMAL profile) one shared copy is kept instead and the fixed-rate
+// step is a tail call into it.
+#if defined(__OPTIMIZE_SIZE__)
+  #define PLL_STEP_INLINE __attribute__((noinline))
+#else
+  #define PLL_STEP_INLINE inline __attribute__((always_inline))
+#endif
@@ -3,10 +3,15 @@
 
 #define SINE_N 1024
 
+// Placement attribute for the table (pll_q30.c sets PLL_HOT_RODATA here)
+#ifndef SINE_Q230_ATTR
+#define SINE_Q230_ATTR
+#endif
+
 // Q2.30 sine table: 1024 samples, amplitude = 1.0
 // NOT: Bu tabloyu bir sonraki adımda otomatik üreteceğiz.
 // Şimdilik yer tutucu; dosya boş kalmasın diye minimum test değerleri:
-static const int32_t sine_q230[SINE_N] = {
+static const int32_t sine_q230[SINE_N] SINE_Q230_ATTR = {
     0x00000000, 0x006487C4, 0x00C90E90, 0x012D936C, 0x0192155F, 0x01F69373, 0x025B0CAF, 0x02BF801A, 
     0x0323ECBE, 0x038851A2, 0x03ECADCF, 0x0451004D, 0x04B54825, 0x0519845E, 0x057DB403, 0x05E1D61B, 
     0x0645E9AF, 0x06A9EDC9, 0x070DE172, 0x0771C3B3, 0x07D59396, 0x08395024, 0x089CF867, 0x09008B6A,